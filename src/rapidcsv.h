@@ -14,8 +14,16 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cerrno>
+#include <clocale>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
 #ifdef HAS_CODECVT
 #include <codecvt>
 #include <locale>
@@ -24,13 +32,53 @@
 #include <functional>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <system_error>
+#include <thread>
+#include <typeindex>
 #include <typeinfo>
 #include <vector>
 
+#if defined(__has_include)
+#if __has_include(<charconv>)
+#if (__cplusplus >= 201703L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 201703L))
+#include <charconv>
+#endif
+#endif
+#endif
+#if defined(__cpp_lib_to_chars)
+#if __cpp_lib_to_chars >= 201611L
+#define RAPIDCSV_HAS_CHARCONV
+#endif
+#endif
+
+#if !defined(RAPIDCSV_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+#define RAPIDCSV_HAS_SSE2
+#include <emmintrin.h>
+#if defined(__linux__) && (defined(__GNUC__) || defined(__clang__))
+#define RAPIDCSV_HAS_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+#include <intrin.h>
+#endif
+
+#if !defined(_WIN32) && (defined(__unix__) || defined(__APPLE__))
+#define RAPIDCSV_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace rapidcsv
 {
 #if defined(_MSC_VER)
@@ -54,7 +102,10 @@ namespace rapidcsv
      * @param   pDefaultFloat         floating-point default value to represent invalid numbers.
      * @param   pDefaultInteger       integer default value to represent invalid numbers.
      * @param   pNumericLocale        specifies whether to honor LC_NUMERIC locale (default
-     *                                true).
+     *                                true). Whether the decimal point of the locale is '.' is
+     *                                detected when a Document is constructed or loaded (or a
+     *                                Reader or IndexedReader is constructed), so a Document
+     *                                should be loaded again after changing the locale.
      */
     explicit ConverterParams(const bool pHasDefaultConverter = false,
                              const long double pDefaultFloat = std::numeric_limits<long double>::signaling_NaN(),
@@ -106,1886 +157,6719 @@ namespace rapidcsv
     }
   };
 
-  /**
-   * @brief     Class providing conversion to/from numerical datatypes and strings. Only
-   *            intended for rapidcsv internal usage, but exposed externally to allow
-   *            specialization for custom datatype conversions.
-   */
-  template<typename T>
-  class Converter
+  namespace detail
   {
-  public:
-    /**
-     * @brief   Constructor
-     * @param   pConverterParams      specifies how conversion of non-numerical values to
-     *                                numerical datatype shall be handled.
-     */
-    Converter(const ConverterParams& pConverterParams)
-      : mConverterParams(pConverterParams)
-    {
-    }
-
     /**
-     * @brief   Converts numerical value to string representation.
-     * @param   pVal                  numerical value
-     * @param   pStr                  output string
+     * @brief   Parses a decimal integer in the plain format [+-]digits, spanning the whole input.
+     * @param   pStr                  input data.
+     * @param   pLength               input length.
+     * @param   pVal                  receives the value.
+     * @returns false if the input does not match the format, or its value does not fit in T.
      */
-    void ToStr(const T& pVal, std::string& pStr) const
+    template<typename T>
+    inline bool ParseInteger(const char* pStr, const size_t pLength, T& pVal)
     {
-      if (typeid(T) == typeid(int) ||
-          typeid(T) == typeid(short) ||
-          typeid(T) == typeid(unsigned short) ||
-          typeid(T) == typeid(long) ||
-          typeid(T) == typeid(long long) ||
-          typeid(T) == typeid(unsigned) ||
-          typeid(T) == typeid(unsigned long) ||
-          typeid(T) == typeid(unsigned long long) ||
-          typeid(T) == typeid(long double) ||
-          typeid(T) == typeid(char))
-      {
-        std::ostringstream out;
-        out << pVal;
-        pStr = out.str();
-      }
-      else if (typeid(T) == typeid(float))
-      {
-        std::ostringstream out;
-        out << std::setprecision(9) << pVal;
-        pStr = out.str();
-      }
-      else if (typeid(T) == typeid(double))
+      const char* pos = pStr;
+      const char* const end = pStr + pLength;
+      bool negative = false;
+      if ((pos != end) && ((*pos == '-') || (*pos == '+')))
       {
-        std::ostringstream out;
-        out << std::setprecision(17) << pVal;
-        pStr = out.str();
+        negative = (*pos == '-');
+        ++pos;
       }
-      else if (typeid(T) == typeid(signed char))
+
+      // negative values of unsigned types are left to the standard library, which wraps them
+      if ((pos == end) || (negative && !std::numeric_limits<T>::is_signed))
       {
-        std::ostringstream out;
-        out << static_cast<int>(pVal);
-        pStr = out.str();
+        return false;
       }
-      else if (typeid(T) == typeid(unsigned char))
+
+      const unsigned long long limit = static_cast<unsigned long long>(std::numeric_limits<T>::max()) +
+        (negative ? 1 : 0);
+      unsigned long long val = 0;
+      for (; pos != end; ++pos)
       {
-        std::ostringstream out;
-        out << static_cast<unsigned int>(pVal);
-        pStr = out.str();
+        const unsigned digit = static_cast<unsigned>(*pos - '0');
+        if ((digit > 9) || (val > ((limit - digit) / 10)))
+        {
+          return false;
+        }
+        val = (val * 10) + digit;
       }
-      else
+
+      pVal = negative ? static_cast<T>(-static_cast<long long>(val - 1) - 1) : static_cast<T>(val);
+      return true;
+    }
+
+    template<typename T>
+    inline T Pow10(const int pExponent)
+    {
+      static const double sPow10[] =
       {
-        throw no_converter();
-      }
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+      };
+      return static_cast<T>(sPow10[pExponent]);
     }
 
     /**
-     * @brief   Converts string holding a numerical value to numerical datatype representation.
-     * @param   pVal                  numerical value
-     * @param   pStr                  output string
+     * @brief   Parses a decimal float or double in the plain format
+     *          [+-]digits[.digits][(e|E)[+-]digits], spanning the whole input. Numbers whose
+     *          significand and power of ten are both exactly representable in T are computed
+     *          with a single correctly rounded multiplication or division (Clinger's fast path).
+     *          Other numbers are converted using std::from_chars when available.
+     * @param   pStr                  input data.
+     * @param   pLength               input length.
+     * @param   pVal                  receives the value.
+     * @returns false if the input does not match the format or could not be converted.
      */
-    void ToVal(const std::string& pStr, T& pVal) const
+    template<typename T>
+    inline bool ParseFloat(const char* pStr, const size_t pLength, T& pVal)
     {
-      try
+      const char* pos = pStr;
+      const char* const end = pStr + pLength;
+      bool negative = false;
+      if ((pos != end) && ((*pos == '-') || (*pos == '+')))
+      {
+        negative = (*pos == '-');
+        ++pos;
+      }
+
+      const char* const unsignedStr = pos;
+      uint64_t significand = 0;
+      int significantDigits = 0;
+      int exponent = 0;
+      bool hasDigits = false;
+      bool exact = true;
+      bool fraction = false;
+      for (; pos != end; ++pos)
       {
-        if (typeid(T) == typeid(int))
+        if ((*pos == '.') && !fraction)
         {
-          pVal = static_cast<T>(std::stoi(pStr));
-          return;
+          fraction = true;
+          continue;
         }
-        else if (typeid(T) == typeid(signed char))
+
+        const unsigned digit = static_cast<unsigned>(*pos - '0');
+        if (digit > 9)
         {
-          pVal = static_cast<T>(std::stoi(pStr));
-          return;
+          break;
         }
-        else if (typeid(T) == typeid(unsigned char))
+
+        hasDigits = true;
+        if (significantDigits < 19)
         {
-          pVal = static_cast<T>(std::stoi(pStr));
-          return;
+          significand = (significand * 10) + digit;
+          significantDigits += (significand != 0) ? 1 : 0;
+          exponent -= fraction ? 1 : 0;
         }
-        else if (typeid(T) == typeid(short))
+        else
         {
-          pVal = static_cast<T>(std::stoi(pStr));
-          return;
+          exact = false;
         }
-        else if (typeid(T) == typeid(unsigned short))
+      }
+
+      if (hasDigits && (pos != end) && ((*pos == 'e') || (*pos == 'E')))
+      {
+        ++pos;
+        bool negativeExponent = false;
+        if ((pos != end) && ((*pos == '-') || (*pos == '+')))
         {
-          pVal = static_cast<T>(std::stoi(pStr));
-          return;
+          negativeExponent = (*pos == '-');
+          ++pos;
         }
-        else if (typeid(T) == typeid(long))
+
+        if (pos == end)
         {
-          pVal = static_cast<T>(std::stol(pStr));
-          return;
+          return false;
         }
-        else if (typeid(T) == typeid(long long))
+
+        int exponentVal = 0;
+        for (; pos != end; ++pos)
         {
-          pVal = static_cast<T>(std::stoll(pStr));
-          return;
+          const unsigned digit = static_cast<unsigned>(*pos - '0');
+          if (digit > 9)
+          {
+            return false;
+          }
+          exponentVal = (exponentVal < 100000) ? ((exponentVal * 10) + static_cast<int>(digit)) : exponentVal;
         }
-        else if (typeid(T) == typeid(unsigned))
+        exponent += negativeExponent ? -exponentVal : exponentVal;
+      }
+
+      if (!hasDigits || (pos != end))
+      {
+        return false;
+      }
+
+      const int maxExactExponent = (std::numeric_limits<T>::digits >= 53) ? 22 : 10;
+      if (exact && (significand <= (uint64_t(1) << std::numeric_limits<T>::digits)) &&
+          (exponent >= -maxExactExponent) && (exponent <= maxExactExponent))
+      {
+        T val = static_cast<T>(significand);
+        if (exponent < 0)
         {
-          pVal = static_cast<T>(std::stoul(pStr));
-          return;
+          val /= Pow10<T>(-exponent);
         }
-        else if (typeid(T) == typeid(unsigned long))
+        else
         {
-          pVal = static_cast<T>(std::stoul(pStr));
-          return;
+          val *= Pow10<T>(exponent);
+        }
+        pVal = negative ? -val : val;
+        return true;
+      }
+
+#ifdef RAPIDCSV_HAS_CHARCONV
+      T val = 0;
+      const std::from_chars_result result = std::from_chars(unsignedStr, end, val);
+
+      // subnormal results are left to the standard library, which reports them as out of range
+      if ((result.ec == std::errc()) && (result.ptr == end) && ((significand == 0) || std::isnormal(val)))
+      {
+        pVal = negative ? -val : val;
+        return true;
+      }
+#else
+      (void)unsignedStr;
+#endif
+
+      return false;
+    }
+
+    /**
+     * @brief   Returns true if the decimal point of the current C locale is '.'.
+     */
+    inline bool IsDecimalPointDot()
+    {
+      const struct lconv* lc = std::localeconv();
+      return (lc != nullptr) && (lc->decimal_point != nullptr) &&
+             (std::strcmp(lc->decimal_point, ".") == 0);
+    }
+
+    /**
+     * @brief   Numeric properties of the current locale, detected once when loading data
+     *          rather than by every Converter.
+     */
+    struct NumericLocale
+    {
+      NumericLocale()
+        : mDecimalPointDot(IsDecimalPointDot())
+        , mClassic(std::locale() == std::locale::classic())
+      {
+      }
+
+      bool mDecimalPointDot;
+      bool mClassic;
+    };
+
+    /**
+     * @brief   Formats an integer as decimal digits without using a stream.
+     * @param   pMagnitude            absolute value.
+     * @param   pNegative             specifies whether the value is negative.
+     * @param   pStr                  output string.
+     */
+    inline void FormatInteger(unsigned long long pMagnitude, const bool pNegative, std::string& pStr)
+    {
+      char buf[24];
+      char* const end = buf + sizeof(buf);
+      char* pos = end;
+      do
+      {
+        *--pos = static_cast<char>('0' + (pMagnitude % 10));
+        pMagnitude /= 10;
+      }
+      while (pMagnitude != 0);
+
+      if (pNegative)
+      {
+        *--pos = '-';
+      }
+      pStr.assign(pos, static_cast<size_t>(end - pos));
+    }
+
+    inline void FormatInteger(const long long pVal, std::string& pStr)
+    {
+      FormatInteger((pVal < 0) ? (0ull - static_cast<unsigned long long>(pVal)) : static_cast<unsigned long long>(pVal),
+                    (pVal < 0), pStr);
+    }
+
+    inline void FormatInteger(const unsigned long long pVal, std::string& pStr)
+    {
+      FormatInteger(pVal, false, pStr);
+    }
+
+    /**
+     * @brief   Splits a number in scientific notation [-]d[.ddd]e(+|-)dd into its sign, significant
+     *          digits (without trailing zeros) and decimal exponent.
+     * @param   pSci                  number in scientific notation.
+     * @param   pNegative             receives whether the number is negative.
+     * @param   pDigits               receives the digits, buffer of at least 32 chars.
+     * @param   pDigitCount           receives the number of digits.
+     * @param   pExponent             receives the exponent of the first digit.
+     */
+    inline void SplitScientific(const char* pSci, bool& pNegative, char* pDigits, size_t& pDigitCount,
+                                int& pExponent)
+    {
+      const char* pos = pSci;
+      pNegative = (*pos == '-');
+      pos += pNegative ? 1 : 0;
+
+      pDigitCount = 0;
+      for (; (*pos != 'e') && (*pos != '\0'); ++pos)
+      {
+        if ((*pos != '.') && (pDigitCount < 32))
+        {
+          pDigits[pDigitCount++] = *pos;
+        }
+      }
+
+      pExponent = (*pos == 'e') ? std::atoi(pos + 1) : 0;
+      while ((pDigitCount > 1) && (pDigits[pDigitCount - 1] == '0'))
+      {
+        --pDigitCount;
+      }
+    }
+
+    /**
+     * @brief   Renders a number given as significant digits and exponent the same way as a stream
+     *          with the specified precision does, but using only the given digits.
+     * @param   pNegative             specifies whether the number is negative.
+     * @param   pDigits               significant digits.
+     * @param   pDigitCount           number of digits.
+     * @param   pExponent             exponent of the first digit.
+     * @param   pPrecision            precision controlling the choice of fixed or scientific notation.
+     * @param   pStr                  output string.
+     */
+    inline void FormatDigits(const bool pNegative, const char* pDigits, const size_t pDigitCount,
+                             const int pExponent, const int pPrecision, std::string& pStr)
+    {
+      char buf[64];
+      size_t len = 0;
+      if (pNegative)
+      {
+        buf[len++] = '-';
+      }
+
+      if ((pExponent < -4) || (pExponent >= pPrecision))
+      {
+        buf[len++] = pDigits[0];
+        if (pDigitCount > 1)
+        {
+          buf[len++] = '.';
+          std::memcpy(buf + len, pDigits + 1, pDigitCount - 1);
+          len += pDigitCount - 1;
         }
-        else if (typeid(T) == typeid(unsigned long long))
+
+        buf[len++] = 'e';
+        buf[len++] = (pExponent < 0) ? '-' : '+';
+        const int absExponent = std::abs(pExponent);
+        if (absExponent >= 100)
         {
-          pVal = static_cast<T>(std::stoull(pStr));
-          return;
+          buf[len++] = static_cast<char>('0' + (absExponent / 100));
         }
+        buf[len++] = static_cast<char>('0' + ((absExponent / 10) % 10));
+        buf[len++] = static_cast<char>('0' + (absExponent % 10));
       }
-      catch (...)
+      else if (pExponent < 0)
       {
-        if (!mConverterParams.mHasDefaultConverter)
+        buf[len++] = '0';
+        buf[len++] = '.';
+        for (int i = -1; i > pExponent; --i)
         {
-          throw;
+          buf[len++] = '0';
         }
-        else
+        std::memcpy(buf + len, pDigits, pDigitCount);
+        len += pDigitCount;
+      }
+      else
+      {
+        const size_t intDigits = static_cast<size_t>(pExponent) + 1;
+        for (size_t i = 0; i < std::max(intDigits, pDigitCount); ++i)
         {
-          pVal = static_cast<T>(mConverterParams.mDefaultInteger);
-          return;
+          if (i == intDigits)
+          {
+            buf[len++] = '.';
+          }
+          buf[len++] = (i < pDigitCount) ? pDigits[i] : '0';
         }
       }
 
-      try
+      pStr.assign(buf, len);
+    }
+
+#ifndef RAPIDCSV_HAS_CHARCONV
+    inline float StrToFloat(const char* pStr, float)
+    {
+      return std::strtof(pStr, nullptr);
+    }
+
+    inline double StrToFloat(const char* pStr, double)
+    {
+      return std::strtod(pStr, nullptr);
+    }
+
+    /**
+     * @brief   Shortens the max_digits10 significant digits of a float or double to the fewest
+     *          digits which, correctly rounded, still convert back to the same value. For normal
+     *          numbers the search starts at digits10, as all shorter representations round-trip
+     *          too.
+     * @param   pVal                  value.
+     * @param   pDigits               significant digits, updated in place.
+     * @param   pDigitCount           number of digits, updated in place.
+     * @param   pExponent             exponent of the first digit, updated in place.
+     */
+    template<typename T>
+    inline void ShortenDigits(const T pVal, char* pDigits, size_t& pDigitCount, int& pExponent)
+    {
+      const T absVal = std::abs(pVal);
+      const bool subnormal = (pVal != 0) && !std::isnormal(pVal);
+      for (size_t precision = subnormal ? 1 : std::numeric_limits<T>::digits10; precision < pDigitCount; ++precision)
       {
-        if (mConverterParams.mNumericLocale)
+        char rounded[32];
+        std::memcpy(rounded, pDigits, precision);
+        int exponent = pExponent;
+        if (pDigits[precision] >= '5')
         {
-          if (typeid(T) == typeid(float))
+          size_t i = precision;
+          while ((i > 0) && (rounded[i - 1] == '9'))
           {
-            pVal = static_cast<T>(std::stof(pStr));
-            return;
+            rounded[--i] = '0';
           }
-          else if (typeid(T) == typeid(double))
+
+          if (i == 0)
           {
-            pVal = static_cast<T>(std::stod(pStr));
-            return;
+            rounded[0] = '1';
+            ++exponent;
           }
-          else if (typeid(T) == typeid(long double))
+          else
           {
-            pVal = static_cast<T>(std::stold(pStr));
-            return;
+            ++rounded[i - 1];
           }
         }
-        else
+
+        // candidate in the form <digits>e<exponent>
+        char candidate[48];
+        std::memcpy(candidate, rounded, precision);
+        size_t len = precision;
+        candidate[len++] = 'e';
+        int candidateExponent = exponent - static_cast<int>(precision - 1);
+        if (candidateExponent < 0)
         {
-          if ((typeid(T) == typeid(float)) ||
-              (typeid(T) == typeid(double)) ||
-              (typeid(T) == typeid(long double)))
-          {
-            std::istringstream iss(pStr);
-            iss.imbue(std::locale::classic());
-            iss >> pVal;
-            if (iss.fail() || iss.bad() || !iss.eof())
-            {
-              throw std::invalid_argument("istringstream: no conversion");
-            }
-            return;
-          }
+          candidate[len++] = '-';
+          candidateExponent = -candidateExponent;
         }
-      }
-      catch (...)
-      {
-        if (!mConverterParams.mHasDefaultConverter)
+
+        char exponentDigits[8];
+        size_t exponentLen = 0;
+        do
         {
-          throw;
+          exponentDigits[exponentLen++] = static_cast<char>('0' + (candidateExponent % 10));
+          candidateExponent /= 10;
         }
-        else
+        while (candidateExponent != 0);
+
+        while (exponentLen > 0)
         {
-          pVal = static_cast<T>(mConverterParams.mDefaultFloat);
-          return;
+          candidate[len++] = exponentDigits[--exponentLen];
         }
-      }
+        candidate[len] = '\0';
 
-      if (typeid(T) == typeid(char))
-      {
-        pVal = static_cast<T>(pStr[0]);
-        return;
+        T parsed = 0;
+        if (!ParseFloat(candidate, len, parsed))
+        {
+          parsed = StrToFloat(candidate, pVal);
+        }
+
+        if (parsed == absVal)
+        {
+          std::memcpy(pDigits, rounded, precision);
+          pDigitCount = precision;
+          pExponent = exponent;
+          break;
+        }
       }
-      else
+
+      while ((pDigitCount > 1) && (pDigits[pDigitCount - 1] == '0'))
       {
-        throw no_converter();
+        --pDigitCount;
       }
     }
+#endif
 
-  private:
-    const ConverterParams& mConverterParams;
-  };
-
-  /**
-   * @brief     Specialized implementation handling string to string conversion.
-   * @param     pVal                  string
-   * @param     pStr                  string
-   */
-  template<>
-  inline void Converter<std::string>::ToStr(const std::string& pVal, std::string& pStr) const
-  {
-    pStr = pVal;
-  }
-
-  /**
-   * @brief     Specialized implementation handling string to string conversion.
-   * @param     pVal                  string
-   * @param     pStr                  string
-   */
-  template<>
-  inline void Converter<std::string>::ToVal(const std::string& pStr, std::string& pVal) const
-  {
-    pVal = pStr;
-  }
-
-  template<typename T>
-  using ConvFunc = std::function<void (const std::string& pStr, T& pVal)>;
-
-  /**
-   * @brief     Datastructure holding parameters controlling which row and column should be
-   *            treated as labels.
-   */
-  struct LabelParams
-  {
     /**
-     * @brief   Constructor
-     * @param   pColumnNameIdx        specifies the zero-based row index of the column labels, setting
-     *                                it to -1 prevents column lookup by label name, and gives access
-     *                                to all rows as document data. Default: 0
-     * @param   pRowNameIdx           specifies the zero-based column index of the row labels, setting
-     *                                it to -1 prevents row lookup by label name, and gives access
-     *                                to all columns as document data. Default: -1
+     * @brief   Formats a float or double using the shortest decimal representation that
+     *          converts back to the same value, in the notation a stream with precision
+     *          max_digits10 would use.
+     * @param   pVal                  value.
+     * @param   pStr                  output string.
+     * @returns false if the value is not finite.
      */
-    explicit LabelParams(const int pColumnNameIdx = 0, const int pRowNameIdx = -1)
-      : mColumnNameIdx(pColumnNameIdx)
-      , mRowNameIdx(pRowNameIdx)
+    template<typename T>
+    inline bool FormatFloat(const T pVal, std::string& pStr)
     {
-      if (mColumnNameIdx < -1)
+      if (!std::isfinite(pVal))
       {
-        const std::string errStr = "invalid column name index " +
-          std::to_string(mColumnNameIdx) + " < -1";
-        throw std::out_of_range(errStr);
+        return false;
       }
 
-      if (mRowNameIdx < -1)
+      char buf[40];
+#ifdef RAPIDCSV_HAS_CHARCONV
+      const std::to_chars_result result = std::to_chars(buf, buf + sizeof(buf) - 1, pVal,
+                                                        std::chars_format::scientific);
+      if (result.ec != std::errc())
       {
-        const std::string errStr = "invalid row name index " +
-          std::to_string(mRowNameIdx) + " < -1";
-        throw std::out_of_range(errStr);
+        return false;
       }
+      *result.ptr = '\0';
+#else
+      snprintf(buf, sizeof(buf), "%.*e", std::numeric_limits<T>::max_digits10 - 1, static_cast<double>(pVal));
+#endif
+
+      bool negative = false;
+      char digits[32];
+      size_t digitCount = 0;
+      int exponent = 0;
+      SplitScientific(buf, negative, digits, digitCount, exponent);
+#ifndef RAPIDCSV_HAS_CHARCONV
+      ShortenDigits(pVal, digits, digitCount, exponent);
+#endif
+      FormatDigits(negative, digits, digitCount, exponent, std::numeric_limits<T>::max_digits10, pStr);
+      return true;
     }
 
     /**
-     * @brief   specifies the zero-based row index of the column labels.
+     * @brief   Conversion categories of the datatypes supported by Converter, used to select
+     *          the conversion code at compile time. TParse / TFloat is the type values are parsed
+     *          as before being cast to the requested datatype.
      */
-    int mColumnNameIdx;
+    struct NoConversionTag
+    {
+    };
 
-    /**
-     * @brief   specifies the zero-based column index of the row labels.
-     */
-    int mRowNameIdx;
-  };
+    struct CharTag
+    {
+    };
+
+    template<typename TParse>
+    struct IntegerTag
+    {
+    };
+
+    template<typename TFloat>
+    struct FloatTag
+    {
+    };
+
+    struct LongDoubleTag
+    {
+    };
+
+    template<typename T>
+    struct ConversionTag
+    {
+      typedef NoConversionTag Type;
+    };
+
+    template<>
+    struct ConversionTag<char>
+    {
+      typedef CharTag Type;
+    };
+
+    template<>
+    struct ConversionTag<signed char>
+    {
+      typedef IntegerTag<int> Type;
+    };
+
+    template<>
+    struct ConversionTag<unsigned char>
+    {
+      typedef IntegerTag<int> Type;
+    };
+
+    template<>
+    struct ConversionTag<short>
+    {
+      typedef IntegerTag<int> Type;
+    };
+
+    template<>
+    struct ConversionTag<unsigned short>
+    {
+      typedef IntegerTag<int> Type;
+    };
+
+    template<>
+    struct ConversionTag<int>
+    {
+      typedef IntegerTag<int> Type;
+    };
+
+    template<>
+    struct ConversionTag<unsigned>
+    {
+      typedef IntegerTag<unsigned long> Type;
+    };
+
+    template<>
+    struct ConversionTag<long>
+    {
+      typedef IntegerTag<long> Type;
+    };
+
+    template<>
+    struct ConversionTag<unsigned long>
+    {
+      typedef IntegerTag<unsigned long> Type;
+    };
+
+    template<>
+    struct ConversionTag<long long>
+    {
+      typedef IntegerTag<long long> Type;
+    };
+
+    template<>
+    struct ConversionTag<unsigned long long>
+    {
+      typedef IntegerTag<unsigned long long> Type;
+    };
+
+    template<>
+    struct ConversionTag<float>
+    {
+      typedef FloatTag<float> Type;
+    };
+
+    template<>
+    struct ConversionTag<double>
+    {
+      typedef FloatTag<double> Type;
+    };
+
+    template<>
+    struct ConversionTag<long double>
+    {
+      typedef LongDoubleTag Type;
+    };
 
-  /**
-   * @brief     Datastructure holding parameters controlling how the CSV data fields are separated.
-   */
-  struct SeparatorParams
-  {
     /**
-     * @brief   Constructor
-     * @param   pSeparator            specifies the column separator (default ',').
-     * @param   pTrim                 specifies whether to trim leading and trailing spaces from
-     *                                cells read (default false).
-     * @param   pHasCR                specifies whether a new document (i.e. not an existing document read)
-     *                                should use CR/LF instead of only LF (default is to use standard
-     *                                behavior of underlying platforms - CR/LF for Win, and LF for others).
-     * @param   pQuotedLinebreaks     specifies whether to allow line breaks in quoted text (default false)
-     * @param   pAutoQuote            specifies whether to automatically dequote data during read, and add
-     *                                quotes during write (default true).
-     * @param   pQuoteChar            specifies the quote character (default '\"').
+     * @brief   Converts a string to a number using the standard library conversion function
+     *          for the given type, throwing std::invalid_argument or std::out_of_range on error.
      */
-    explicit SeparatorParams(const char pSeparator = ',', const bool pTrim = false,
-                             const bool pHasCR = sPlatformHasCR, const bool pQuotedLinebreaks = false,
-                             const bool pAutoQuote = true, const char pQuoteChar = '"')
-      : mSeparator(pSeparator)
-      , mTrim(pTrim)
-      , mHasCR(pHasCR)
-      , mQuotedLinebreaks(pQuotedLinebreaks)
-      , mAutoQuote(pAutoQuote)
-      , mQuoteChar(pQuoteChar)
+    inline void StdToVal(const std::string& pStr, int& pVal)
     {
+      pVal = std::stoi(pStr);
     }
 
-    /**
-     * @brief   specifies the column separator.
-     */
-    char mSeparator;
+    inline void StdToVal(const std::string& pStr, long& pVal)
+    {
+      pVal = std::stol(pStr);
+    }
 
-    /**
-     * @brief   specifies whether to trim leading and trailing spaces from cells read.
-     */
-    bool mTrim;
+    inline void StdToVal(const std::string& pStr, long long& pVal)
+    {
+      pVal = std::stoll(pStr);
+    }
 
-    /**
-     * @brief   specifies whether new documents should use CR/LF instead of LF.
-     */
-    bool mHasCR;
+    inline void StdToVal(const std::string& pStr, unsigned long& pVal)
+    {
+      pVal = std::stoul(pStr);
+    }
 
-    /**
-     * @brief   specifies whether to allow line breaks in quoted text.
-     */
-    bool mQuotedLinebreaks;
+    inline void StdToVal(const std::string& pStr, unsigned long long& pVal)
+    {
+      pVal = std::stoull(pStr);
+    }
 
-    /**
-     * @brief   specifies whether to automatically dequote cell data.
-     */
-    bool mAutoQuote;
+    inline void StdToVal(const std::string& pStr, float& pVal)
+    {
+      pVal = std::stof(pStr);
+    }
+
+    inline void StdToVal(const std::string& pStr, double& pVal)
+    {
+      pVal = std::stod(pStr);
+    }
+
+    inline void StdToVal(const std::string& pStr, long double& pVal)
+    {
+      pVal = std::stold(pStr);
+    }
 
     /**
-     * @brief   specifies the quote character.
+     * @brief   Converts a string to a number using a C library conversion function, accepting
+     *          the same input as StdToVal(), but returning false on error instead of throwing.
      */
-    char mQuoteChar;
-  };
+    template<typename T, typename TFunc>
+    inline bool StrToVal(const std::string& pStr, T& pVal, TFunc pFunc)
+    {
+      const char* const str = pStr.c_str();
+      char* end = nullptr;
+      const int savedErrno = errno;
+      errno = 0;
+      pVal = pFunc(str, &end);
+      const bool rv = (end != str) && (errno != ERANGE);
+      errno = savedErrno;
+      return rv;
+    }
+
+    inline bool StdTryToVal(const std::string& pStr, long& pVal)
+    {
+      return StrToVal(pStr, pVal, [](const char* pPtr, char** pEnd) { return std::strtol(pPtr, pEnd, 10); });
+    }
+
+    inline bool StdTryToVal(const std::string& pStr, int& pVal)
+    {
+      long val = 0;
+      if (!StdTryToVal(pStr, val) || (val < std::numeric_limits<int>::min()) ||
+          (val > std::numeric_limits<int>::max()))
+      {
+        return false;
+      }
+
+      pVal = static_cast<int>(val);
+      return true;
+    }
+
+    inline bool StdTryToVal(const std::string& pStr, long long& pVal)
+    {
+      return StrToVal(pStr, pVal, [](const char* pPtr, char** pEnd) { return std::strtoll(pPtr, pEnd, 10); });
+    }
+
+    inline bool StdTryToVal(const std::string& pStr, unsigned long& pVal)
+    {
+      return StrToVal(pStr, pVal, [](const char* pPtr, char** pEnd) { return std::strtoul(pPtr, pEnd, 10); });
+    }
+
+    inline bool StdTryToVal(const std::string& pStr, unsigned long long& pVal)
+    {
+      return StrToVal(pStr, pVal, [](const char* pPtr, char** pEnd) { return std::strtoull(pPtr, pEnd, 10); });
+    }
+
+    inline bool StdTryToVal(const std::string& pStr, float& pVal)
+    {
+      return StrToVal(pStr, pVal, [](const char* pPtr, char** pEnd) { return std::strtof(pPtr, pEnd); });
+    }
+
+    inline bool StdTryToVal(const std::string& pStr, double& pVal)
+    {
+      return StrToVal(pStr, pVal, [](const char* pPtr, char** pEnd) { return std::strtod(pPtr, pEnd); });
+    }
+
+    inline bool StdTryToVal(const std::string& pStr, long double& pVal)
+    {
+      return StrToVal(pStr, pVal, [](const char* pPtr, char** pEnd) { return std::strtold(pPtr, pEnd); });
+    }
+  }
 
   /**
-   * @brief     Datastructure holding parameters controlling how special line formats should be
-   *            treated.
+   * @brief     Class providing conversion to/from numerical datatypes and strings. Only
+   *            intended for rapidcsv internal usage, but exposed externally to allow
+   *            specialization for custom datatype conversions.
    */
-  struct LineReaderParams
+  template<typename T>
+  class Converter
   {
+  public:
     /**
      * @brief   Constructor
-     * @param   pSkipCommentLines     specifies whether to skip lines prefixed with
-     *                                mCommentPrefix. Default: false
-     * @param   pCommentPrefix        specifies which prefix character to indicate a comment
-     *                                line. Default: #
-     * @param   pSkipEmptyLines       specifies whether to skip empty lines. Default: false
+     * @param   pConverterParams      specifies how conversion of non-numerical values to
+     *                                numerical datatype shall be handled.
      */
-    explicit LineReaderParams(const bool pSkipCommentLines = false,
-                              const char pCommentPrefix = '#',
-                              const bool pSkipEmptyLines = false)
-      : mSkipCommentLines(pSkipCommentLines)
-      , mCommentPrefix(pCommentPrefix)
-      , mSkipEmptyLines(pSkipEmptyLines)
+    Converter(const ConverterParams& pConverterParams)
+      : Converter(pConverterParams, detail::NumericLocale())
     {
     }
 
     /**
-     * @brief   specifies whether to skip lines prefixed with mCommentPrefix.
+     * @brief   Constructor
+     * @param   pConverterParams      specifies how conversion of non-numerical values to
+     *                                numerical datatype shall be handled.
+     * @param   pNumericLocale        numeric properties of the current locale.
      */
-    bool mSkipCommentLines;
+    Converter(const ConverterParams& pConverterParams, const detail::NumericLocale& pNumericLocale)
+      : mConverterParams(pConverterParams)
+      , mFastFloat(!pConverterParams.mNumericLocale || pNumericLocale.mDecimalPointDot)
+      , mFastToStr(pNumericLocale.mClassic && pNumericLocale.mDecimalPointDot)
+    {
+    }
 
     /**
-     * @brief   specifies which prefix character to indicate a comment line.
+     * @brief   Converts numerical value to string representation.
+     * @param   pVal                  numerical value
+     * @param   pStr                  output string
      */
-    char mCommentPrefix;
+    void ToStr(const T& pVal, std::string& pStr) const
+    {
+      ToStr(pVal, pStr, typename detail::ConversionTag<T>::Type());
+    }
 
     /**
-     * @brief   specifies whether to skip empty lines.
+     * @brief   Converts string holding a numerical value to numerical datatype representation.
+     * @param   pVal                  numerical value
+     * @param   pStr                  output string
      */
-    bool mSkipEmptyLines;
-  };
+    void ToVal(const std::string& pStr, T& pVal) const
+    {
+      ToVal(pStr, pVal, typename detail::ConversionTag<T>::Type());
+    }
 
-  /**
-   * @brief     Class representing a CSV document.
-   */
-  class Document
-  {
-  public:
+  private:
     /**
-     * @brief   Constructor
-     * @param   pPath                 specifies the path of an existing CSV-file to populate the Document
-     *                                data with.
-     * @param   pLabelParams          specifies which row and column should be treated as labels.
-     * @param   pSeparatorParams      specifies which field and row separators should be used.
-     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
-     *                                handled.
-     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @brief   Formats integers without using a stream, unless a non-classic locale was
+     *          active when the Document or Writer was constructed or loaded.
      */
-    explicit Document(const std::string& pPath = std::string(),
-                      const LabelParams& pLabelParams = LabelParams(),
-                      const SeparatorParams& pSeparatorParams = SeparatorParams(),
-                      const ConverterParams& pConverterParams = ConverterParams(),
-                      const LineReaderParams& pLineReaderParams = LineReaderParams())
-      : mPath(pPath)
-      , mLabelParams(pLabelParams)
-      , mSeparatorParams(pSeparatorParams)
-      , mConverterParams(pConverterParams)
-      , mLineReaderParams(pLineReaderParams)
-      , mData()
-      , mColumnNames()
-      , mRowNames()
+    template<typename TParse>
+    void ToStr(const T& pVal, std::string& pStr, detail::IntegerTag<TParse>) const
     {
-      if (!mPath.empty())
+      if (mFastToStr)
       {
-        ReadCsv();
+        if (std::numeric_limits<T>::is_signed)
+        {
+          detail::FormatInteger(static_cast<long long>(pVal), pStr);
+        }
+        else
+        {
+          detail::FormatInteger(static_cast<unsigned long long>(pVal), pStr);
+        }
+        return;
       }
+
+      std::ostringstream out;
+      out << static_cast<TParse>(pVal);
+      pStr = out.str();
     }
 
     /**
-     * @brief   Constructor
-     * @param   pStream               specifies a binary input stream to read CSV data from.
-     * @param   pLabelParams          specifies which row and column should be treated as labels.
-     * @param   pSeparatorParams      specifies which field and row separators should be used.
-     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
-     *                                handled.
-     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @brief   Formats finite floats and doubles using their shortest round-trip representation
+     *          without using a stream, unless a non-classic locale was active when the
+     *          Document or Writer was constructed or loaded.
      */
-    explicit Document(std::istream& pStream,
-                      const LabelParams& pLabelParams = LabelParams(),
-                      const SeparatorParams& pSeparatorParams = SeparatorParams(),
-                      const ConverterParams& pConverterParams = ConverterParams(),
-                      const LineReaderParams& pLineReaderParams = LineReaderParams())
-      : mPath()
-      , mLabelParams(pLabelParams)
-      , mSeparatorParams(pSeparatorParams)
-      , mConverterParams(pConverterParams)
-      , mLineReaderParams(pLineReaderParams)
-      , mData()
-      , mColumnNames()
-      , mRowNames()
+    template<typename TFloat>
+    void ToStr(const T& pVal, std::string& pStr, detail::FloatTag<TFloat>) const
     {
-      ReadCsv(pStream);
+      if (mFastToStr && detail::FormatFloat(static_cast<TFloat>(pVal), pStr))
+      {
+        return;
+      }
+
+      std::ostringstream out;
+      out << std::setprecision(std::numeric_limits<TFloat>::max_digits10) << pVal;
+      pStr = out.str();
     }
 
-    /**
-     * @brief   Read Document data from file.
-     * @param   pPath                 specifies the path of an existing CSV-file to populate the Document
-     *                                data with.
-     * @param   pLabelParams          specifies which row and column should be treated as labels.
-     * @param   pSeparatorParams      specifies which field and row separators should be used.
-     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
-     *                                handled.
+    void ToStr(const T& pVal, std::string& pStr, detail::LongDoubleTag) const
+    {
+      std::ostringstream out;
+      out << pVal;
+      pStr = out.str();
+    }
+
+    void ToStr(const T& pVal, std::string& pStr, detail::CharTag) const
+    {
+      std::ostringstream out;
+      out << pVal;
+      pStr = out.str();
+    }
+
+    void ToStr(const T& /*pVal*/, std::string& /*pStr*/, detail::NoConversionTag) const
+    {
+      throw no_converter();
+    }
+
+    /**
+     * @brief   Converts integers in plain decimal format directly from the string, and other
+     *          formats using the standard library conversion functions. Invalid numbers are
+     *          replaced by the default value, if enabled, without throwing an exception.
+     */
+    template<typename TParse>
+    void ToVal(const std::string& pStr, T& pVal, detail::IntegerTag<TParse>) const
+    {
+      TParse val = 0;
+      if (detail::ParseInteger(pStr.data(), pStr.size(), val))
+      {
+        pVal = static_cast<T>(val);
+      }
+      else if (mConverterParams.mHasDefaultConverter)
+      {
+        pVal = detail::StdTryToVal(pStr, val) ? static_cast<T>(val)
+                                              : static_cast<T>(mConverterParams.mDefaultInteger);
+      }
+      else
+      {
+        detail::StdToVal(pStr, val);
+        pVal = static_cast<T>(val);
+      }
+    }
+
+    /**
+     * @brief   Converts floats and doubles in plain decimal format directly from the string
+     *          (if the decimal point of the locale in use is '.'), and other formats using the
+     *          standard library.
+     */
+    template<typename TFloat>
+    void ToVal(const std::string& pStr, T& pVal, detail::FloatTag<TFloat>) const
+    {
+      TFloat val = 0;
+      if (mFastFloat && detail::ParseFloat(pStr.data(), pStr.size(), val))
+      {
+        pVal = static_cast<T>(val);
+        return;
+      }
+
+      ToFloat(pStr, pVal);
+    }
+
+    void ToVal(const std::string& pStr, T& pVal, detail::LongDoubleTag) const
+    {
+      ToFloat(pStr, pVal);
+    }
+
+    void ToVal(const std::string& pStr, T& pVal, detail::CharTag) const
+    {
+      pVal = static_cast<T>(pStr[0]);
+    }
+
+    void ToVal(const std::string& /*pStr*/, T& /*pVal*/, detail::NoConversionTag) const
+    {
+      throw no_converter();
+    }
+
+    /**
+     * @brief   Converts floating-point numbers using the standard library. Invalid numbers are
+     *          replaced by the default value, if enabled, without throwing an exception.
+     */
+    void ToFloat(const std::string& pStr, T& pVal) const
+    {
+      if (mConverterParams.mNumericLocale && !mConverterParams.mHasDefaultConverter)
+      {
+        detail::StdToVal(pStr, pVal);
+      }
+      else if (!TryToFloat(pStr, pVal))
+      {
+        if (!mConverterParams.mHasDefaultConverter)
+        {
+          throw std::invalid_argument("istringstream: no conversion");
+        }
+
+        pVal = static_cast<T>(mConverterParams.mDefaultFloat);
+      }
+    }
+
+    bool TryToFloat(const std::string& pStr, T& pVal) const
+    {
+      if (mConverterParams.mNumericLocale)
+      {
+        return detail::StdTryToVal(pStr, pVal);
+      }
+
+      std::istringstream iss(pStr);
+      iss.imbue(std::locale::classic());
+      iss >> pVal;
+      return !(iss.fail() || iss.bad() || !iss.eof());
+    }
+
+  private:
+    ConverterParams mConverterParams;
+    bool mFastFloat;
+    bool mFastToStr;
+  };
+
+  /**
+   * @brief     Specialized implementation handling string to string conversion.
+   * @param     pVal                  string
+   * @param     pStr                  string
+   */
+  template<>
+  inline void Converter<std::string>::ToStr(const std::string& pVal, std::string& pStr) const
+  {
+    pStr = pVal;
+  }
+
+  /**
+   * @brief     Specialized implementation handling string to string conversion.
+   * @param     pVal                  string
+   * @param     pStr                  string
+   */
+  template<>
+  inline void Converter<std::string>::ToVal(const std::string& pStr, std::string& pVal) const
+  {
+    pVal = pStr;
+  }
+
+  template<typename T>
+  using ConvFunc = std::function<void (const std::string& pStr, T& pVal)>;
+
+  /**
+   * @brief     Datastructure holding parameters controlling which row and column should be
+   *            treated as labels.
+   */
+  struct LabelParams
+  {
+    /**
+     * @brief   Constructor
+     * @param   pColumnNameIdx        specifies the zero-based row index of the column labels, setting
+     *                                it to -1 prevents column lookup by label name, and gives access
+     *                                to all rows as document data. Default: 0
+     * @param   pRowNameIdx           specifies the zero-based column index of the row labels, setting
+     *                                it to -1 prevents row lookup by label name, and gives access
+     *                                to all columns as document data. Default: -1
+     */
+    explicit LabelParams(const int pColumnNameIdx = 0, const int pRowNameIdx = -1)
+      : mColumnNameIdx(pColumnNameIdx)
+      , mRowNameIdx(pRowNameIdx)
+    {
+      if (mColumnNameIdx < -1)
+      {
+        const std::string errStr = "invalid column name index " +
+          std::to_string(mColumnNameIdx) + " < -1";
+        throw std::out_of_range(errStr);
+      }
+
+      if (mRowNameIdx < -1)
+      {
+        const std::string errStr = "invalid row name index " +
+          std::to_string(mRowNameIdx) + " < -1";
+        throw std::out_of_range(errStr);
+      }
+    }
+
+    /**
+     * @brief   specifies the zero-based row index of the column labels.
+     */
+    int mColumnNameIdx;
+
+    /**
+     * @brief   specifies the zero-based column index of the row labels.
+     */
+    int mRowNameIdx;
+  };
+
+  /**
+   * @brief     Datastructure holding parameters controlling how the CSV data fields are separated.
+   */
+  struct SeparatorParams
+  {
+    /**
+     * @brief   Constructor
+     * @param   pSeparator            specifies the column separator (default ',').
+     * @param   pTrim                 specifies whether to trim leading and trailing spaces from
+     *                                cells read (default false).
+     * @param   pHasCR                specifies whether a new document (i.e. not an existing document read)
+     *                                should use CR/LF instead of only LF (default is to use standard
+     *                                behavior of underlying platforms - CR/LF for Win, and LF for others).
+     * @param   pQuotedLinebreaks     specifies whether to allow line breaks in quoted text (default false)
+     * @param   pAutoQuote            specifies whether to automatically dequote data during read, and add
+     *                                quotes during write (default true).
+     * @param   pQuoteChar            specifies the quote character (default '\"').
+     */
+    explicit SeparatorParams(const char pSeparator = ',', const bool pTrim = false,
+                             const bool pHasCR = sPlatformHasCR, const bool pQuotedLinebreaks = false,
+                             const bool pAutoQuote = true, const char pQuoteChar = '"')
+      : mSeparator(pSeparator)
+      , mTrim(pTrim)
+      , mHasCR(pHasCR)
+      , mQuotedLinebreaks(pQuotedLinebreaks)
+      , mAutoQuote(pAutoQuote)
+      , mQuoteChar(pQuoteChar)
+    {
+    }
+
+    /**
+     * @brief   specifies the column separator.
+     */
+    char mSeparator;
+
+    /**
+     * @brief   specifies whether to trim leading and trailing spaces from cells read.
+     */
+    bool mTrim;
+
+    /**
+     * @brief   specifies whether new documents should use CR/LF instead of LF.
+     */
+    bool mHasCR;
+
+    /**
+     * @brief   specifies whether to allow line breaks in quoted text.
+     */
+    bool mQuotedLinebreaks;
+
+    /**
+     * @brief   specifies whether to automatically dequote cell data.
+     */
+    bool mAutoQuote;
+
+    /**
+     * @brief   specifies the quote character.
+     */
+    char mQuoteChar;
+  };
+
+  /**
+   * @brief     Datastructure holding parameters controlling how special line formats should be
+   *            treated.
+   */
+  struct LineReaderParams
+  {
+    /**
+     * @brief   Constructor
+     * @param   pSkipCommentLines     specifies whether to skip lines prefixed with
+     *                                mCommentPrefix. Default: false
+     * @param   pCommentPrefix        specifies which prefix character to indicate a comment
+     *                                line. Default: #
+     * @param   pSkipEmptyLines       specifies whether to skip empty lines. Default: false
+     */
+    explicit LineReaderParams(const bool pSkipCommentLines = false,
+                              const char pCommentPrefix = '#',
+                              const bool pSkipEmptyLines = false)
+      : mSkipCommentLines(pSkipCommentLines)
+      , mCommentPrefix(pCommentPrefix)
+      , mSkipEmptyLines(pSkipEmptyLines)
+    {
+    }
+
+    /**
+     * @brief   specifies whether to skip lines prefixed with mCommentPrefix.
+     */
+    bool mSkipCommentLines;
+
+    /**
+     * @brief   specifies which prefix character to indicate a comment line.
+     */
+    char mCommentPrefix;
+
+    /**
+     * @brief   specifies whether to skip empty lines.
+     */
+    bool mSkipEmptyLines;
+  };
+
+  /**
+   * @brief     Function type for load-time row filtering. Returns true to keep the row.
+   */
+  using RowFilterFunc = std::function<bool (const std::vector<std::string>& pRow)>;
+
+  /**
+   * @brief     Datastructure holding parameters controlling how CSV data is loaded.
+   */
+  struct LoadParams
+  {
+    /**
+     * @brief   Constructor
+     * @param   pMemoryMap            specifies whether to memory map files (when supported by the
+     *                                platform) and parse directly from the mapping, instead of
+     *                                reading them through a stream. Pipes and other non-regular
+     *                                files are always read as streams. Default: false
+     * @param   pThreads              specifies the number of threads used for parsing. With more
+     *                                than one thread the data is read into memory (unless memory
+     *                                mapped), split into chunks at row boundaries, and the chunks
+     *                                are parsed concurrently. Zero selects one thread per hardware
+     *                                thread. Default: 1
+     * @param   pArenaStorage         specifies whether to store cell data in a single contiguous
+     *                                buffer with a flat table of cell offsets, rather than as one
+     *                                string per cell. This reduces memory usage and load time for
+     *                                large files. The Document is converted to regular storage on
+     *                                its first modification. Default: false
+     * @param   pSelectedColumnIdxs   specifies zero-based indices of the data columns to load.
+     *                                Cells of other columns are skipped while parsing, and the
+     *                                Document only contains the selected columns, in their
+     *                                original order. Label columns are always loaded. If neither
+     *                                indices nor names are specified, all columns are loaded.
+     *                                An index past the last column (of the column label row, or
+     *                                the first row without labels) throws std::out_of_range.
+     *                                Default: empty
+     * @param   pSelectedColumnNames  specifies names of additional data columns to load, looked
+     *                                up in the column label row. A name not found throws
+     *                                std::out_of_range. Default: empty
+     * @param   pRowFilter            specifies a function deciding which data rows to load. It
+     *                                receives the loaded cells of each row (after column
+     *                                selection, including any row label cell), and returns true
+     *                                to keep the row. Label rows are always kept. With more than
+     *                                one thread it is called concurrently. Default: none
+     */
+    explicit LoadParams(const bool pMemoryMap = false, const unsigned pThreads = 1,
+                        const bool pArenaStorage = false,
+                        const std::vector<size_t>& pSelectedColumnIdxs = std::vector<size_t>(),
+                        const std::vector<std::string>& pSelectedColumnNames = std::vector<std::string>(),
+                        const RowFilterFunc& pRowFilter = RowFilterFunc())
+      : mMemoryMap(pMemoryMap)
+      , mThreads(pThreads)
+      , mArenaStorage(pArenaStorage)
+      , mSelectedColumnIdxs(pSelectedColumnIdxs)
+      , mSelectedColumnNames(pSelectedColumnNames)
+      , mRowFilter(pRowFilter)
+    {
+    }
+
+    /**
+     * @brief   specifies whether to memory map files.
+     */
+    bool mMemoryMap;
+
+    /**
+     * @brief   specifies the number of threads used for parsing.
+     */
+    unsigned mThreads;
+
+    /**
+     * @brief   specifies whether to store cell data in a single contiguous buffer.
+     */
+    bool mArenaStorage;
+
+    /**
+     * @brief   specifies indices of the data columns to load.
+     */
+    std::vector<size_t> mSelectedColumnIdxs;
+
+    /**
+     * @brief   specifies names of the data columns to load.
+     */
+    std::vector<std::string> mSelectedColumnNames;
+
+    /**
+     * @brief   specifies a function deciding which data rows to load.
+     */
+    RowFilterFunc mRowFilter;
+  };
+
+  /**
+   * @brief     Datastructure holding parameters controlling how CSV data is saved.
+   */
+  struct SaveParams
+  {
+    /**
+     * @brief   Constructor
+     * @param   pThreads              specifies the number of threads used for formatting rows.
+     *                                With more than one thread, ranges of rows are formatted
+     *                                concurrently into separate buffers, which are then written
+     *                                in order (to files using positioned writes, when supported
+     *                                by the platform). The output is identical to saving with
+     *                                one thread. Zero selects one thread per hardware thread.
+     *                                Default: 1
+     * @param   pAtomic               specifies whether to write files to a temporary file in the
+     *                                same directory, which then replaces the target file by a
+     *                                rename. Readers of the file thus see either the previous or
+     *                                the complete new contents, never a partially written file.
+     *                                On platforms other than Linux and macOS the target file is
+     *                                removed before the rename, so the replacement is not atomic.
+     *                                The permission bits of the target file are kept on Linux and
+     *                                macOS, while its owner and group become those of the process.
+     *                                Default: false
+     * @param   pSync                 specifies whether to flush an atomically saved file (and the
+     *                                rename) to storage before returning, when supported by the
+     *                                platform, so the new contents survive a system crash.
+     *                                Default: false
+     * @param   pAppend               specifies whether to only append the rows added since the
+     *                                Document was loaded from or last saved to the same file.
+     *                                The file is fully rewritten instead if any earlier row,
+     *                                column or label was modified, when saving to another path,
+     *                                for UTF-16 data, and (on Linux and macOS) if the size or
+     *                                modification time of the file changed since it was loaded
+     *                                or saved. Appending is not atomic.
+     *                                Default: false
+     */
+    explicit SaveParams(const unsigned pThreads = 1, const bool pAtomic = false, const bool pSync = false,
+                        const bool pAppend = false)
+      : mThreads(pThreads)
+      , mAtomic(pAtomic)
+      , mSync(pSync)
+      , mAppend(pAppend)
+    {
+    }
+
+    /**
+     * @brief   specifies the number of threads used for formatting rows.
+     */
+    unsigned mThreads;
+
+    /**
+     * @brief   specifies whether to replace files atomically using a temporary file.
+     */
+    bool mAtomic;
+
+    /**
+     * @brief   specifies whether to flush atomically saved files to storage.
+     */
+    bool mSync;
+
+    /**
+     * @brief   specifies whether to only append rows added since the last load or save.
+     */
+    bool mAppend;
+  };
+
+  /**
+   * @brief     Datastructure holding parameters controlling the row index of IndexedReader.
+   */
+  struct IndexParams
+  {
+    /**
+     * @brief   Constructor
+     * @param   pRowInterval          specifies the number of rows between indexed row offsets.
+     *                                Reading a row parses at most this many rows, while the
+     *                                index size is the row count divided by it.
+     *                                Default: 1024
+     * @param   pIndexFile            specifies whether to store the index in a file next to the
+     *                                CSV-file (with ".idx" appended to its path), which is used
+     *                                instead of scanning the CSV-file again, as long as the size
+     *                                and modification time of the CSV-file are unchanged. Only
+     *                                supported on Linux and macOS. Default: false
+     */
+    explicit IndexParams(const size_t pRowInterval = 1024, const bool pIndexFile = false)
+      : mRowInterval(pRowInterval)
+      , mIndexFile(pIndexFile)
+    {
+    }
+
+    /**
+     * @brief   specifies the number of rows between indexed row offsets.
+     */
+    size_t mRowInterval;
+
+    /**
+     * @brief   specifies whether to store the index in a file next to the CSV-file.
+     */
+    bool mIndexFile;
+  };
+
+  namespace detail
+  {
+    /**
+     * @brief     Instruction set used when scanning CSV data for structural characters.
+     */
+    enum SimdLevel
+    {
+      SimdScalar = 0,
+      SimdSse2 = 1,
+      SimdAvx2 = 2
+    };
+
+    typedef uint64_t (* BlockMaskFunc)(const char* pBlock, const char* pChars);
+
+    inline int CountTrailingZeros(uint64_t pVal)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+      return __builtin_ctzll(pVal);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+      unsigned long idx = 0;
+      _BitScanForward64(&idx, pVal);
+      return static_cast<int>(idx);
+#else
+      int count = 0;
+      while ((pVal & 1) == 0)
+      {
+        pVal >>= 1;
+        ++count;
+      }
+      return count;
+#endif
+    }
+
+    /**
+     * @brief   Returns a bitmask with bit i set if pBlock[i] equals any of the four characters
+     *          in pChars, for a block of 64 bytes.
+     */
+    inline uint64_t BlockMaskScalar(const char* pBlock, const char* pChars)
+    {
+      uint64_t mask = 0;
+      for (int i = 0; i < 64; ++i)
+      {
+        const char ch = pBlock[i];
+        if ((ch == pChars[0]) || (ch == pChars[1]) || (ch == pChars[2]) || (ch == pChars[3]))
+        {
+          mask |= (static_cast<uint64_t>(1) << i);
+        }
+      }
+      return mask;
+    }
+
+#ifdef RAPIDCSV_HAS_SSE2
+    inline uint64_t BlockMaskSse2(const char* pBlock, const char* pChars)
+    {
+      const __m128i c0 = _mm_set1_epi8(pChars[0]);
+      const __m128i c1 = _mm_set1_epi8(pChars[1]);
+      const __m128i c2 = _mm_set1_epi8(pChars[2]);
+      const __m128i c3 = _mm_set1_epi8(pChars[3]);
+      uint64_t mask = 0;
+      for (int i = 0; i < 4; ++i)
+      {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBlock + (16 * i)));
+        const __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(data, c0), _mm_cmpeq_epi8(data, c1)),
+                                          _mm_or_si128(_mm_cmpeq_epi8(data, c2), _mm_cmpeq_epi8(data, c3)));
+        mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(hits))) << (16 * i);
+      }
+      return mask;
+    }
+#endif
+
+#ifdef RAPIDCSV_HAS_AVX2
+    __attribute__((target("avx2")))
+    inline uint64_t BlockMaskAvx2(const char* pBlock, const char* pChars)
+    {
+      const __m256i c0 = _mm256_set1_epi8(pChars[0]);
+      const __m256i c1 = _mm256_set1_epi8(pChars[1]);
+      const __m256i c2 = _mm256_set1_epi8(pChars[2]);
+      const __m256i c3 = _mm256_set1_epi8(pChars[3]);
+      const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pBlock));
+      const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pBlock + 32));
+      const __m256i hitsLo = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(lo, c0), _mm256_cmpeq_epi8(lo, c1)),
+                                             _mm256_or_si256(_mm256_cmpeq_epi8(lo, c2), _mm256_cmpeq_epi8(lo, c3)));
+      const __m256i hitsHi = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(hi, c0), _mm256_cmpeq_epi8(hi, c1)),
+                                             _mm256_or_si256(_mm256_cmpeq_epi8(hi, c2), _mm256_cmpeq_epi8(hi, c3)));
+      return static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(hitsLo))) |
+             (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(hitsHi))) << 32);
+    }
+#endif
+
+    /**
+     * @brief   Returns the best instruction set supported by the running CPU.
+     */
+    inline SimdLevel GetSupportedSimdLevel()
+    {
+#if defined(RAPIDCSV_HAS_AVX2)
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx2"))
+      {
+        return SimdAvx2;
+      }
+#endif
+#if defined(RAPIDCSV_HAS_SSE2)
+      return SimdSse2;
+#else
+      return SimdScalar;
+#endif
+    }
+
+    inline SimdLevel& ActiveSimdLevel()
+    {
+      static SimdLevel level = GetSupportedSimdLevel();
+      return level;
+    }
+
+    /**
+     * @brief   Returns the instruction set currently used for structural scanning.
+     */
+    inline SimdLevel GetSimdLevel()
+    {
+      return ActiveSimdLevel();
+    }
+
+    /**
+     * @brief   Selects the instruction set used for structural scanning, limited to what the
+     *          running CPU supports. Mainly intended for testing, and must not be called while
+     *          another thread is parsing.
+     * @param   pLevel                requested instruction set.
+     */
+    inline void SetSimdLevel(const SimdLevel pLevel)
+    {
+      ActiveSimdLevel() = std::min(pLevel, GetSupportedSimdLevel());
+    }
+
+    inline BlockMaskFunc GetBlockMaskFunc(const SimdLevel pLevel)
+    {
+      switch (pLevel)
+      {
+#ifdef RAPIDCSV_HAS_AVX2
+        case SimdAvx2:
+          return BlockMaskAvx2;
+#endif
+#ifdef RAPIDCSV_HAS_SSE2
+        case SimdSse2:
+          return BlockMaskSse2;
+#endif
+        case SimdScalar:
+        default:
+          return BlockMaskScalar;
+      }
+    }
+
+    /**
+     * @brief   Locates quote, separator, CR and LF characters in a buffer. A bitmask of such
+     *          positions is computed once per 64 byte block, so that consecutive lookups within
+     *          a block only cost a shift and a count of trailing zeros.
+     */
+    class StructuralScanner
+    {
+    public:
+      StructuralScanner(const char pQuoteChar, const char pSeparator)
+        : mFunc(GetBlockMaskFunc(GetSimdLevel()))
+        , mChars{ pQuoteChar, pSeparator, '\r', '\n' }
+        , mEnd(nullptr)
+        , mBlock(nullptr)
+        , mBlockEnd(nullptr)
+        , mMask(0)
+      {
+      }
+
+      void Reset(const char* pBegin, const char* pEnd)
+      {
+        mEnd = pEnd;
+        mBlock = pBegin;
+        mBlockEnd = pBegin;
+        mMask = 0;
+      }
+
+      /**
+       * @brief   Find next structural character.
+       * @param   pPos                position to start searching from.
+       * @returns pointer to the next structural character at or after pPos, or end of buffer.
+       */
+      const char* Next(const char* pPos)
+      {
+        while (pPos < mEnd)
+        {
+          if (pPos >= mBlockEnd)
+          {
+            LoadBlock(pPos);
+          }
+
+          const uint64_t mask = mMask >> (pPos - mBlock);
+          if (mask != 0)
+          {
+            return pPos + CountTrailingZeros(mask);
+          }
+
+          pPos = mBlockEnd;
+        }
+
+        return mEnd;
+      }
+
+    private:
+      void LoadBlock(const char* pPos)
+      {
+        mBlock = pPos;
+        const size_t remaining = static_cast<size_t>(mEnd - pPos);
+        if (remaining >= 64)
+        {
+          mBlockEnd = pPos + 64;
+          mMask = mFunc(pPos, mChars);
+        }
+        else
+        {
+          char tail[64] = { };
+          std::memcpy(tail, pPos, remaining);
+          mBlockEnd = mEnd;
+          mMask = mFunc(tail, mChars) & ((static_cast<uint64_t>(1) << remaining) - 1);
+        }
+      }
+
+    private:
+      BlockMaskFunc mFunc;
+      char mChars[4];
+      const char* mEnd;
+      const char* mBlock;
+      const char* mBlockEnd;
+      uint64_t mMask;
+    };
+
+    /**
+     * @brief   Formats cells as CSV into an output buffer. With auto quoting, cells containing
+     *          the separator, a space or a linefeed are quoted, with quote characters doubled.
+     *          Each cell is scanned once, using block masks for long cells and a lookup table
+     *          for short ones.
+     */
+    class CellFormatter
+    {
+    public:
+      explicit CellFormatter(const SeparatorParams& pSeparatorParams)
+        : mFunc(GetBlockMaskFunc(GetSimdLevel()))
+        , mChars{ pSeparatorParams.mSeparator, ' ', '\n', pSeparatorParams.mQuoteChar }
+        , mClass()
+        , mAutoQuote(pSeparatorParams.mAutoQuote)
+        , mSeparator(pSeparatorParams.mSeparator)
+        , mQuoteChar(pSeparatorParams.mQuoteChar)
+        , mLineEnd(pSeparatorParams.mHasCR ? "\r\n" : "\n")
+      {
+        for (int i = 0; i < 3; ++i)
+        {
+          mClass[static_cast<unsigned char>(mChars[i])] |= sNeedsQuote;
+        }
+        mClass[static_cast<unsigned char>(mQuoteChar)] |= sHasQuote;
+      }
+
+      /**
+       * @brief   Append a cell.
+       * @param   pData               cell data.
+       * @param   pLength             length of cell data.
+       * @param   pOut                output buffer.
+       */
+      void AppendCell(const char* pData, const size_t pLength, std::string& pOut) const
+      {
+        const unsigned char cellClass = mAutoQuote ? Classify(pData, pLength) : 0;
+        if ((cellClass & sNeedsQuote) == 0)
+        {
+          pOut.append(pData, pLength);
+          return;
+        }
+
+        pOut += mQuoteChar;
+        if ((cellClass & sHasQuote) == 0)
+        {
+          pOut.append(pData, pLength);
+        }
+        else
+        {
+          const char* pos = pData;
+          const char* const end = pData + pLength;
+          while (pos < end)
+          {
+            const void* quote = std::memchr(pos, mQuoteChar, static_cast<size_t>(end - pos));
+            const char* next = (quote != nullptr) ? (static_cast<const char*>(quote) + 1) : end;
+            pOut.append(pos, static_cast<size_t>(next - pos));
+            if (quote != nullptr)
+            {
+              pOut += mQuoteChar;
+            }
+            pos = next;
+          }
+        }
+        pOut += mQuoteChar;
+      }
+
+      void AppendSeparator(std::string& pOut) const
+      {
+        pOut += mSeparator;
+      }
+
+      void AppendLineEnd(std::string& pOut) const
+      {
+        pOut += mLineEnd;
+      }
+
+    private:
+      unsigned char Classify(const char* pData, const size_t pLength) const
+      {
+        unsigned char cellClass = 0;
+        size_t pos = 0;
+        for (; (pos + 64) <= pLength; pos += 64)
+        {
+          uint64_t mask = mFunc(pData + pos, mChars);
+          while (mask != 0)
+          {
+            cellClass |= mClass[static_cast<unsigned char>(pData[pos + static_cast<size_t>(CountTrailingZeros(mask))])];
+            mask &= (mask - 1);
+          }
+        }
+
+        for (; pos < pLength; ++pos)
+        {
+          cellClass |= mClass[static_cast<unsigned char>(pData[pos])];
+        }
+
+        return cellClass;
+      }
+
+    private:
+      static const unsigned char sNeedsQuote = 1;
+      static const unsigned char sHasQuote = 2;
+      BlockMaskFunc mFunc;
+      char mChars[4];
+      unsigned char mClass[256];
+      bool mAutoQuote;
+      char mSeparator;
+      char mQuoteChar;
+      std::string mLineEnd;
+    };
+
+    /**
+     * @brief   Incremental CSV tokenizer. Input may be provided in arbitrarily sized pieces, and
+     *          cells are passed to the handler (trimmed and unquoted as configured) through
+     *          OnCell(const char* pData, size_t pLength), followed by OnRowEnd() for each row.
+     *          Empty and comment lines are skipped according to the line reader parameters, in
+     *          which case no handler calls are made for the line.
+     */
+    class Tokenizer
+    {
+    public:
+      Tokenizer(const SeparatorParams& pSeparatorParams, const LineReaderParams& pLineReaderParams)
+        : mSeparatorParams(pSeparatorParams)
+        , mLineReaderParams(pLineReaderParams)
+        , mScanner(pSeparatorParams.mQuoteChar, pSeparatorParams.mSeparator)
+        , mCell()
+        , mQuoted(false)
+        , mColumnIdx(0)
+        , mSkipRow(false)
+        , mCR(0)
+        , mLF(0)
+      {
+      }
+
+      /**
+       * @brief   Parse a piece of CSV data.
+       * @param   pData               data to parse.
+       * @param   pLength             length of data.
+       * @param   pHandler            handler receiving cells and row ends.
+       * @param   pStopAtRowEnd       specifies whether to return after the first completed row.
+       * @returns number of bytes consumed.
+       */
+      template<typename THandler>
+      size_t Parse(const char* pData, const size_t pLength, THandler& pHandler, const bool pStopAtRowEnd = false)
+      {
+        const char* const end = pData + pLength;
+        mScanner.Reset(pData, end);
+        for (const char* pos = pData; pos < end; ++pos)
+        {
+          // copy plain characters up to next quote, separator or linebreak in bulk
+          const char* special = mScanner.Next(pos);
+          mCell.append(pos, static_cast<size_t>(special - pos));
+          pos = special;
+          if (pos == end)
+          {
+            break;
+          }
+
+          if (*pos == mSeparatorParams.mQuoteChar)
+          {
+            if (mCell.empty() || (mCell[0] == mSeparatorParams.mQuoteChar))
+            {
+              mQuoted = !mQuoted;
+            }
+            else if (mSeparatorParams.mTrim)
+            {
+              // allow whitespace before first mQuoteChar
+              const auto firstQuote = std::find(mCell.begin(), mCell.end(), mSeparatorParams.mQuoteChar);
+              if (std::all_of(mCell.begin(), firstQuote, [](unsigned char ch) { return isspace(ch); }))
+              {
+                mQuoted = !mQuoted;
+              }
+            }
+            mCell += *pos;
+          }
+          else if (*pos == mSeparatorParams.mSeparator)
+          {
+            if (!mQuoted)
+            {
+              EndCell(pHandler);
+            }
+            else
+            {
+              mCell += *pos;
+            }
+          }
+          else if (*pos == '\r')
+          {
+            if (mSeparatorParams.mQuotedLinebreaks && mQuoted)
+            {
+              mCell += *pos;
+            }
+            else
+            {
+              ++mCR;
+            }
+          }
+          else
+          {
+            // '\n'
+            if (mSeparatorParams.mQuotedLinebreaks && mQuoted)
+            {
+              mCell += *pos;
+            }
+            else
+            {
+              ++mLF;
+              if (mLineReaderParams.mSkipEmptyLines && (mColumnIdx == 0) && mCell.empty())
+              {
+                // skip empty line
+              }
+              else if (EndRow(pHandler) && pStopAtRowEnd)
+              {
+                return static_cast<size_t>(pos + 1 - pData);
+              }
+            }
+          }
+        }
+
+        return pLength;
+      }
+
+      /**
+       * @brief   Complete parsing at end of data, handling last row without linebreak.
+       * @param   pHandler            handler receiving cells and row ends.
+       * @returns true if a row was completed.
+       */
+      template<typename THandler>
+      bool Finish(THandler& pHandler)
+      {
+        if ((mColumnIdx == 0) && mCell.empty())
+        {
+          // skip empty trailing line
+          return false;
+        }
+
+        return EndRow(pHandler);
+      }
+
+      /**
+       * @brief   Returns true if no partial row is pending.
+       */
+      bool IsAtRowStart() const
+      {
+        return (mColumnIdx == 0) && mCell.empty();
+      }
+
+      int GetCRCount() const
+      {
+        return mCR;
+      }
+
+      int GetLFCount() const
+      {
+        return mLF;
+      }
+
+    private:
+      template<typename THandler>
+      void EndCell(THandler& pHandler)
+      {
+        // trim and unquote in place
+        size_t begin = 0;
+        size_t end = mCell.size();
+        if (mSeparatorParams.mTrim)
+        {
+          while ((begin < end) && isspace(static_cast<unsigned char>(mCell[begin])))
+          {
+            ++begin;
+          }
+
+          while ((end > begin) && isspace(static_cast<unsigned char>(mCell[end - 1])))
+          {
+            --end;
+          }
+        }
+
+        const char quoteChar = mSeparatorParams.mQuoteChar;
+        if (mSeparatorParams.mAutoQuote && ((end - begin) >= 2) &&
+            (mCell[begin] == quoteChar) && (mCell[end - 1] == quoteChar))
+        {
+          // remove start/end quotes
+          ++begin;
+          --end;
+
+          // unescape quotes in string
+          size_t out = begin;
+          for (size_t in = begin; in < end; ++in)
+          {
+            mCell[out++] = mCell[in];
+            if ((mCell[in] == quoteChar) && ((in + 1) < end) && (mCell[in + 1] == quoteChar))
+            {
+              ++in;
+            }
+          }
+          end = out;
+        }
+
+        if (mColumnIdx == 0)
+        {
+          mSkipRow = mLineReaderParams.mSkipCommentLines && (end > begin) &&
+            (mCell[begin] == mLineReaderParams.mCommentPrefix);
+        }
+
+        if (!mSkipRow)
+        {
+          pHandler.OnCell(mCell.data() + begin, end - begin);
+        }
+
+        mCell.clear();
+        ++mColumnIdx;
+      }
+
+      template<typename THandler>
+      bool EndRow(THandler& pHandler)
+      {
+        EndCell(pHandler);
+
+        const bool rowCompleted = !mSkipRow;
+        if (rowCompleted)
+        {
+          pHandler.OnRowEnd();
+        }
+
+        mColumnIdx = 0;
+        mSkipRow = false;
+        mQuoted = false;
+        return rowCompleted;
+      }
+
+    private:
+      SeparatorParams mSeparatorParams;
+      LineReaderParams mLineReaderParams;
+      StructuralScanner mScanner;
+      std::string mCell;
+      bool mQuoted;
+      size_t mColumnIdx;
+      bool mSkipRow;
+      int mCR;
+      int mLF;
+    };
+
+    /**
+     * @brief   Table size, used for reserving storage before parsing.
+     */
+    struct TableSize
+    {
+      TableSize()
+        : mRowCount(0)
+        , mCellCount(0)
+        , mTextLength(0)
+      {
+      }
+
+      size_t mRowCount;
+      size_t mCellCount;
+      size_t mTextLength;
+    };
+
+    /**
+     * @brief   Estimates the table size of CSV data, by extrapolating the number of linebreaks
+     *          and separators in a sample from its beginning.
+     * @param   pSample               data sample.
+     * @param   pSampleLength         length of data sample.
+     * @param   pLength               total length of data.
+     * @param   pSeparator            field separator.
+     * @returns estimated table size, or zero size if the sample contains no linebreak.
+     */
+    inline TableSize EstimateTableSize(const char* pSample, const size_t pSampleLength, const size_t pLength,
+                                       const char pSeparator)
+    {
+      TableSize size;
+      const size_t lineCount = static_cast<size_t>(std::count(pSample, pSample + pSampleLength, '\n'));
+      if (lineCount == 0)
+      {
+        return size;
+      }
+
+      const size_t separatorCount = static_cast<size_t>(std::count(pSample, pSample + pSampleLength, pSeparator));
+      const double scale = static_cast<double>(pLength) / static_cast<double>(pSampleLength);
+      const size_t delimiterCount = static_cast<size_t>(static_cast<double>(lineCount + separatorCount) * scale);
+      size.mRowCount = static_cast<size_t>(static_cast<double>(lineCount) * scale) + 1;
+      size.mCellCount = delimiterCount + 1;
+      size.mTextLength = pLength - std::min(pLength, delimiterCount);
+      return size;
+    }
+
+    /**
+     * @brief   Tokenizer handler collecting rows as vectors of strings.
+     */
+    class RowTable
+    {
+    public:
+      RowTable()
+        : mRows()
+        , mRow()
+      {
+      }
+
+      void OnCell(const char* pData, const size_t pLength)
+      {
+        mRow.emplace_back(pData, pLength);
+      }
+
+      void OnRowEnd()
+      {
+        // move row into the table, expecting the next row to have the same number of cells
+        const size_t cellCount = mRow.size();
+        mRows.push_back(std::move(mRow));
+        mRow.clear();
+        mRow.reserve(cellCount);
+      }
+
+      /**
+       * @brief   Reserve storage for additional rows.
+       */
+      void Reserve(const TableSize& pSize)
+      {
+        mRows.reserve(mRows.size() + pSize.mRowCount);
+        if ((pSize.mRowCount > 0) && mRow.empty())
+        {
+          mRow.reserve((pSize.mCellCount + pSize.mRowCount - 1) / pSize.mRowCount);
+        }
+      }
+
+      /**
+       * @brief   Move all rows of another table to the end of this table.
+       */
+      void Append(RowTable& pOther)
+      {
+        if (mRows.empty())
+        {
+          mRows.swap(pOther.mRows);
+        }
+        else
+        {
+          mRows.reserve(mRows.size() + pOther.mRows.size());
+          std::move(pOther.mRows.begin(), pOther.mRows.end(), std::back_inserter(mRows));
+        }
+        pOther.mRows.clear();
+      }
+
+      std::vector<std::vector<std::string>>& GetRows()
+      {
+        return mRows;
+      }
+
+    private:
+      std::vector<std::vector<std::string>> mRows;
+      std::vector<std::string> mRow;
+    };
+
+    /**
+     * @brief   Tokenizer handler assigning cells to the elements of an existing row vector.
+     */
+    class RowBuilder
+    {
+    public:
+      explicit RowBuilder(std::vector<std::string>& pRow)
+        : mRow(pRow)
+        , mSize(0)
+        , mRowDone(false)
+      {
+      }
+
+      void OnCell(const char* pData, const size_t pLength)
+      {
+        if (mSize < mRow.size())
+        {
+          mRow[mSize].assign(pData, pLength);
+        }
+        else
+        {
+          mRow.emplace_back(pData, pLength);
+        }
+        ++mSize;
+      }
+
+      void OnRowEnd()
+      {
+        mRow.resize(mSize);
+        mRowDone = true;
+      }
+
+      bool IsRowDone() const
+      {
+        return mRowDone;
+      }
+
+    private:
+      std::vector<std::string>& mRow;
+      size_t mSize;
+      bool mRowDone;
+    };
+
+    /**
+     * @brief   Tokenizer handler counting rows, ignoring cells.
+     */
+    class RowCounter
+    {
+    public:
+      RowCounter()
+        : mCount(0)
+      {
+      }
+
+      void OnCell(const char* /*pData*/, const size_t /*pLength*/)
+      {
+      }
+
+      void OnRowEnd()
+      {
+        ++mCount;
+      }
+
+      size_t GetCount() const
+      {
+        return mCount;
+      }
+
+    private:
+      size_t mCount;
+    };
+
+    /**
+     * @brief   Compact table storage, keeping the text of all cells back to back in one buffer.
+     *          Cells are located through a flat table of cell end offsets, and rows through a
+     *          table of cell end indices. Also serves as tokenizer handler when loading.
+     */
+    class ArenaTable
+    {
+    public:
+      ArenaTable()
+        : mText()
+        , mCellEnds()
+        , mRowEnds()
+      {
+      }
+
+      void OnCell(const char* pData, const size_t pLength)
+      {
+        mText.append(pData, pLength);
+        mCellEnds.push_back(mText.size());
+      }
+
+      void OnRowEnd()
+      {
+        mRowEnds.push_back(mCellEnds.size());
+      }
+
+      /**
+       * @brief   Reserve storage for additional rows.
+       */
+      void Reserve(const TableSize& pSize)
+      {
+        mText.reserve(mText.size() + pSize.mTextLength);
+        mCellEnds.reserve(mCellEnds.size() + pSize.mCellCount);
+        mRowEnds.reserve(mRowEnds.size() + pSize.mRowCount);
+      }
+
+      /**
+       * @brief   Move all rows of another table to the end of this table.
+       */
+      void Append(ArenaTable& pOther)
+      {
+        if (mRowEnds.empty())
+        {
+          Swap(pOther);
+        }
+        else
+        {
+          const size_t textOffset = mText.size();
+          const size_t cellOffset = mCellEnds.size();
+          mText.append(pOther.mText);
+          mCellEnds.reserve(mCellEnds.size() + pOther.mCellEnds.size());
+          for (const size_t cellEnd : pOther.mCellEnds)
+          {
+            mCellEnds.push_back(cellEnd + textOffset);
+          }
+          mRowEnds.reserve(mRowEnds.size() + pOther.mRowEnds.size());
+          for (const size_t rowEnd : pOther.mRowEnds)
+          {
+            mRowEnds.push_back(rowEnd + cellOffset);
+          }
+        }
+        pOther.Clear();
+      }
+
+      void Swap(ArenaTable& pOther)
+      {
+        mText.swap(pOther.mText);
+        mCellEnds.swap(pOther.mCellEnds);
+        mRowEnds.swap(pOther.mRowEnds);
+      }
+
+      /**
+       * @brief   Clear table and release its memory.
+       */
+      void Clear()
+      {
+        ArenaTable empty;
+        Swap(empty);
+      }
+
+      bool IsEmpty() const
+      {
+        return mRowEnds.empty();
+      }
+
+      size_t GetRowCount() const
+      {
+        return mRowEnds.size();
+      }
+
+      size_t GetRowSize(const size_t pRowIdx) const
+      {
+        return mRowEnds.at(pRowIdx) - GetRowBegin(pRowIdx);
+      }
+
+      /**
+       * @brief   Get cell text, pointing into the table buffer.
+       * @param   pRowIdx             zero-based row index.
+       * @param   pColumnIdx          zero-based column index.
+       * @param   pLength             receives the cell length.
+       * @returns pointer to cell data (not null-terminated).
+       */
+      const char* GetCell(const size_t pRowIdx, const size_t pColumnIdx, size_t& pLength) const
+      {
+        if (pColumnIdx >= GetRowSize(pRowIdx))
+        {
+          throw std::out_of_range("column index " + std::to_string(pColumnIdx) + " >= " +
+                                  std::to_string(GetRowSize(pRowIdx)) + " (number of cells on row " +
+                                  std::to_string(pRowIdx) + ")");
+        }
+
+        const size_t cellIdx = GetRowBegin(pRowIdx) + pColumnIdx;
+        const size_t begin = (cellIdx > 0) ? mCellEnds[cellIdx - 1] : 0;
+        pLength = mCellEnds[cellIdx] - begin;
+        return mText.data() + begin;
+      }
+
+      /**
+       * @brief   Copy cell text into a string, reusing its capacity.
+       */
+      void GetCell(const size_t pRowIdx, const size_t pColumnIdx, std::string& pCell) const
+      {
+        size_t length = 0;
+        const char* data = GetCell(pRowIdx, pColumnIdx, length);
+        pCell.assign(data, length);
+      }
+
+      /**
+       * @brief   Copy table contents to row storage, replacing its contents.
+       */
+      void ToRows(std::vector<std::vector<std::string>>& pRows) const
+      {
+        pRows.clear();
+        pRows.resize(mRowEnds.size());
+        for (size_t rowIdx = 0; rowIdx < mRowEnds.size(); ++rowIdx)
+        {
+          std::vector<std::string>& row = pRows[rowIdx];
+          row.reserve(GetRowSize(rowIdx));
+          for (size_t cellIdx = GetRowBegin(rowIdx); cellIdx < mRowEnds[rowIdx]; ++cellIdx)
+          {
+            const size_t begin = (cellIdx > 0) ? mCellEnds[cellIdx - 1] : 0;
+            row.emplace_back(mText.data() + begin, mCellEnds[cellIdx] - begin);
+          }
+        }
+      }
+
+    private:
+      size_t GetRowBegin(const size_t pRowIdx) const
+      {
+        return (pRowIdx > 0) ? mRowEnds.at(pRowIdx - 1) : 0;
+      }
+
+    private:
+      std::string mText;
+      std::vector<size_t> mCellEnds;
+      std::vector<size_t> mRowEnds;
+    };
+
+    /**
+     * @brief   Hash index mapping label names to indices, using open addressing with linear
+     *          probing. Labels are stored in insertion order in a compact entry table, with
+     *          their text back to back in one buffer, and lookups take a pointer and length,
+     *          so no string objects are allocated per label. Setting an existing label
+     *          overwrites its value, i.e. the last duplicate label wins.
+     */
+    class LabelIndex
+    {
+    public:
+      LabelIndex()
+        : mSlots()
+        , mEntries()
+        , mKeys()
+        , mErasedCount(0)
+        , mHasDuplicates(false)
+      {
+      }
+
+      void Clear()
+      {
+        mSlots.clear();
+        mEntries.clear();
+        mKeys.clear();
+        mErasedCount = 0;
+        mHasDuplicates = false;
+      }
+
+      void Reserve(const size_t pCount)
+      {
+        mEntries.reserve(pCount);
+        size_t capacity = sMinCapacity;
+        while ((capacity * 3) < (pCount * 4))
+        {
+          capacity *= 2;
+        }
+
+        if (capacity > mSlots.size())
+        {
+          Rehash(capacity);
+        }
+      }
+
+      void Set(const char* pKey, const size_t pLength, const size_t pValue)
+      {
+        if (((mEntries.size() + 1) * 4) > (mSlots.size() * 3))
+        {
+          Rehash(mSlots.empty() ? sMinCapacity : (mSlots.size() * 2));
+        }
+
+        const uint32_t hash = Hash(pKey, pLength);
+        Slot& slot = mSlots[FindSlot(pKey, pLength, hash)];
+        if (slot.mEntry == 0)
+        {
+          mEntries.push_back(Entry { mKeys.size(), pValue });
+          mKeys.append(pKey, pLength);
+          slot.mHash = hash;
+          slot.mEntry = static_cast<uint32_t>(mEntries.size());
+        }
+        else
+        {
+          mEntries[slot.mEntry - 1].mValue = pValue;
+          mHasDuplicates = true;
+        }
+      }
+
+      void Set(const std::string& pKey, const size_t pValue)
+      {
+        Set(pKey.data(), pKey.size(), pValue);
+      }
+
+      bool Find(const char* pKey, const size_t pLength, size_t& pValue) const
+      {
+        if (mSlots.empty())
+        {
+          return false;
+        }
+
+        const Slot& slot = mSlots[FindSlot(pKey, pLength, Hash(pKey, pLength))];
+        if (slot.mEntry == 0)
+        {
+          return false;
+        }
+
+        pValue = mEntries[slot.mEntry - 1].mValue;
+        return true;
+      }
+
+      bool Find(const std::string& pKey, size_t& pValue) const
+      {
+        return Find(pKey.data(), pKey.size(), pValue);
+      }
+
+      /**
+       * @brief   Removes a label, moving following slots of its probe sequence back into the
+       *          freed slot. The entry is marked as erased, and the entry table is compacted
+       *          once most entries are erased.
+       */
+      bool Erase(const char* pKey, const size_t pLength)
+      {
+        if (mSlots.empty())
+        {
+          return false;
+        }
+
+        size_t hole = FindSlot(pKey, pLength, Hash(pKey, pLength));
+        if (mSlots[hole].mEntry == 0)
+        {
+          return false;
+        }
+
+        mEntries[mSlots[hole].mEntry - 1].mValue = sErased;
+        ++mErasedCount;
+
+        const size_t mask = mSlots.size() - 1;
+        for (size_t next = (hole + 1) & mask; mSlots[next].mEntry != 0; next = (next + 1) & mask)
+        {
+          // move the slot back if the hole lies between its home position and its position
+          const size_t home = mSlots[next].mHash & mask;
+          if (((next - home) & mask) >= ((next - hole) & mask))
+          {
+            mSlots[hole] = mSlots[next];
+            hole = next;
+          }
+        }
+        mSlots[hole] = Slot { 0, 0 };
+
+        if (mErasedCount > GetSize())
+        {
+          Compact();
+        }
+        return true;
+      }
+
+      bool Erase(const std::string& pKey)
+      {
+        return Erase(pKey.data(), pKey.size());
+      }
+
+      /**
+       * @brief   Adds pOffset (which may wrap around to subtract) to all values >= pFirstValue.
+       */
+      void OffsetValues(const size_t pFirstValue, const size_t pOffset)
+      {
+        for (Entry& entry : mEntries)
+        {
+          if ((entry.mValue != sErased) && (entry.mValue >= pFirstValue))
+          {
+            entry.mValue += pOffset;
+          }
+        }
+      }
+
+      /**
+       * @brief   Returns true if a label was set more than once since the index was cleared.
+       */
+      bool HasDuplicates() const
+      {
+        return mHasDuplicates;
+      }
+
+      size_t GetSize() const
+      {
+        return mEntries.size() - mErasedCount;
+      }
+
+      /**
+       * @brief   Returns the number of bytes allocated by the index.
+       */
+      size_t GetMemoryUsage() const
+      {
+        return (mSlots.capacity() * sizeof(Slot)) + (mEntries.capacity() * sizeof(Entry)) + mKeys.capacity();
+      }
+
+    private:
+      struct Slot
+      {
+        uint32_t mHash;
+        uint32_t mEntry; // one-based entry index, zero for empty slots
+      };
+
+      struct Entry
+      {
+        size_t mKeyOffset; // keys are stored in entry order, so the next offset ends the key
+        size_t mValue;
+      };
+
+      static uint32_t Hash(const char* pKey, const size_t pLength)
+      {
+        // FNV-1a
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = 0; i < pLength; ++i)
+        {
+          hash ^= static_cast<unsigned char>(pKey[i]);
+          hash *= 1099511628211ull;
+        }
+        return static_cast<uint32_t>(hash ^ (hash >> 32));
+      }
+
+      // returns the slot holding the key, or the empty slot where it would be inserted
+      size_t FindSlot(const char* pKey, const size_t pLength, const uint32_t pHash) const
+      {
+        const size_t mask = mSlots.size() - 1;
+        size_t idx = pHash & mask;
+        while (true)
+        {
+          const Slot& slot = mSlots[idx];
+          if ((slot.mEntry == 0) || ((slot.mHash == pHash) && IsKey(slot.mEntry - 1, pKey, pLength)))
+          {
+            return idx;
+          }
+          idx = (idx + 1) & mask;
+        }
+      }
+
+      size_t GetKeyLength(const size_t pEntryIdx) const
+      {
+        const size_t end = ((pEntryIdx + 1) < mEntries.size()) ? mEntries[pEntryIdx + 1].mKeyOffset : mKeys.size();
+        return end - mEntries[pEntryIdx].mKeyOffset;
+      }
+
+      bool IsKey(const size_t pEntryIdx, const char* pKey, const size_t pLength) const
+      {
+        return (GetKeyLength(pEntryIdx) == pLength) &&
+               (mKeys.compare(mEntries[pEntryIdx].mKeyOffset, pLength, pKey, pLength) == 0);
+      }
+
+      void Compact()
+      {
+        LabelIndex index;
+        index.Reserve(GetSize());
+        for (size_t i = 0; i < mEntries.size(); ++i)
+        {
+          if (mEntries[i].mValue != sErased)
+          {
+            index.Set(mKeys.data() + mEntries[i].mKeyOffset, GetKeyLength(i), mEntries[i].mValue);
+          }
+        }
+
+        index.mHasDuplicates = mHasDuplicates;
+        std::swap(*this, index);
+      }
+
+      void Rehash(const size_t pCapacity)
+      {
+        std::vector<Slot> slots(pCapacity, Slot { 0, 0 });
+        const size_t mask = pCapacity - 1;
+        for (const Slot& slot : mSlots)
+        {
+          if (slot.mEntry != 0)
+          {
+            size_t idx = slot.mHash & mask;
+            while (slots[idx].mEntry != 0)
+            {
+              idx = (idx + 1) & mask;
+            }
+            slots[idx] = slot;
+          }
+        }
+        mSlots.swap(slots);
+      }
+
+    private:
+      static const size_t sMinCapacity = 16;
+      static const size_t sErased = static_cast<size_t>(-1);
+      std::vector<Slot> mSlots;
+      std::vector<Entry> mEntries;
+      std::string mKeys;
+      size_t mErasedCount;
+      bool mHasDuplicates;
+    };
+
+    /**
+     * @brief   Label index which is built on first use, allowing concurrent readers of a const
+     *          Document to trigger building it.
+     */
+    class LazyLabelIndex
+    {
+    public:
+      LazyLabelIndex()
+        : mIndex()
+        , mBuilt(false)
+        , mMutex()
+      {
+      }
+
+      LazyLabelIndex(const LazyLabelIndex& pOther)
+        : mIndex()
+        , mBuilt(false)
+        , mMutex()
+      {
+        std::lock_guard<std::mutex> lock(pOther.mMutex);
+        mIndex = pOther.mIndex;
+        mBuilt = pOther.mBuilt.load();
+      }
+
+      LazyLabelIndex& operator=(const LazyLabelIndex& pOther)
+      {
+        if (this != &pOther)
+        {
+          LazyLabelIndex other(pOther);
+          std::lock_guard<std::mutex> lock(mMutex);
+          std::swap(mIndex, other.mIndex);
+          mBuilt = other.mBuilt.load();
+        }
+        return *this;
+      }
+
+      /**
+       * @brief   Returns the index, calling pBuild(LabelIndex&) to build it if not yet built.
+       */
+      template<typename TBuild>
+      const LabelIndex& Get(const TBuild& pBuild) const
+      {
+        if (!mBuilt.load(std::memory_order_acquire))
+        {
+          std::lock_guard<std::mutex> lock(mMutex);
+          if (!mBuilt.load(std::memory_order_relaxed))
+          {
+            mIndex.Clear();
+            pBuild(mIndex);
+            mBuilt.store(true, std::memory_order_release);
+          }
+        }
+        return mIndex;
+      }
+
+      /**
+       * @brief   Returns the index for incremental updates, or nullptr if it is not built.
+       */
+      LabelIndex* GetIfBuilt()
+      {
+        return mBuilt.load(std::memory_order_acquire) ? &mIndex : nullptr;
+      }
+
+      void Reset()
+      {
+        mBuilt.store(false, std::memory_order_release);
+        mIndex.Clear();
+      }
+
+    private:
+      mutable LabelIndex mIndex;
+      mutable std::atomic<bool> mBuilt;
+      mutable std::mutex mMutex;
+    };
+
+    /**
+     * @brief   Set of columns to load, specified by data column index and/or name. Names are
+     *          resolved against the column label row once it has been parsed.
+     */
+    class ColumnSelection
+    {
+    public:
+      ColumnSelection(const LabelParams& pLabelParams, const LoadParams& pLoadParams)
+        : mColumnIdxs(pLoadParams.mSelectedColumnIdxs)
+        , mColumnNames(pLoadParams.mSelectedColumnNames)
+        , mColumnNameIdx(pLabelParams.mColumnNameIdx)
+        , mFirstDataColumn(static_cast<size_t>(std::max(0, pLabelParams.mRowNameIdx + 1)))
+        , mSelected()
+        , mResolved(!IsActive())
+        , mColumnCountChecked(mColumnIdxs.empty())
+      {
+        if (!mResolved && (mColumnNames.empty() || (mColumnNameIdx < 0)))
+        {
+          Resolve(std::vector<std::string>());
+        }
+      }
+
+      bool IsActive() const
+      {
+        return !mColumnIdxs.empty() || !mColumnNames.empty();
+      }
+
+      bool IsResolved() const
+      {
+        return mResolved;
+      }
+
+      bool IsColumnCountChecked() const
+      {
+        return mColumnCountChecked;
+      }
+
+      /**
+       * @brief   Returns index of the row determining the column count, as for the Document.
+       */
+      size_t GetColumnCountRowIdx() const
+      {
+        return static_cast<size_t>(std::max(mColumnNameIdx, 0));
+      }
+
+      /**
+       * @brief   Returns number of rows up to and including the column label row.
+       */
+      size_t GetLabelRowCount() const
+      {
+        return static_cast<size_t>(mColumnNameIdx + 1);
+      }
+
+      /**
+       * @brief   Resolve selected columns.
+       * @param   pLabelRow           cells of the column label row.
+       */
+      void Resolve(const std::vector<std::string>& pLabelRow)
+      {
+        mSelected.assign(mFirstDataColumn, true);
+        for (const size_t columnIdx : mColumnIdxs)
+        {
+          Select(mFirstDataColumn + columnIdx);
+        }
+
+        for (const std::string& columnName : mColumnNames)
+        {
+          if (mColumnNameIdx < 0)
+          {
+            throw std::out_of_range("column name row index < 0: " + std::to_string(mColumnNameIdx));
+          }
+
+          // last column with the name takes precedence, as for column lookup by name
+          const auto it = std::find(pLabelRow.rbegin(), pLabelRow.rend(), columnName);
+          const size_t columnIdx = static_cast<size_t>(std::distance(it, pLabelRow.rend())) - 1;
+          if ((it == pLabelRow.rend()) || (columnIdx < mFirstDataColumn))
+          {
+            throw std::out_of_range("column not found: " + columnName);
+          }
+
+          Select(columnIdx);
+        }
+
+        mResolved = true;
+      }
+
+      /**
+       * @brief   Check that selected column indices are within the column count.
+       * @param   pColumnCount        number of cells in the row determining the column count.
+       */
+      void CheckColumnCount(const size_t pColumnCount)
+      {
+        for (const size_t columnIdx : mColumnIdxs)
+        {
+          if ((mFirstDataColumn + columnIdx) >= pColumnCount)
+          {
+            throw std::out_of_range("column index out of range: " + std::to_string(columnIdx));
+          }
+        }
+
+        mColumnCountChecked = true;
+      }
+
+      bool IsSelected(const size_t pColumnIdx) const
+      {
+        return (pColumnIdx < mSelected.size()) && mSelected[pColumnIdx];
+      }
+
+    private:
+      void Select(const size_t pColumnIdx)
+      {
+        if (pColumnIdx >= mSelected.size())
+        {
+          mSelected.resize(pColumnIdx + 1, false);
+        }
+        mSelected[pColumnIdx] = true;
+      }
+
+    private:
+      std::vector<size_t> mColumnIdxs;
+      std::vector<std::string> mColumnNames;
+      int mColumnNameIdx;
+      size_t mFirstDataColumn;
+      std::vector<bool> mSelected;
+      bool mResolved;
+      bool mColumnCountChecked;
+    };
+
+    /**
+     * @brief   Tokenizer handler applying load-time column selection and row filtering, passing
+     *          the remaining cells on to a table. Rows up to and including the column label row
+     *          are held back until the selection has been resolved.
+     */
+    template<typename TTable>
+    class LoadHandler
+    {
+    public:
+      LoadHandler(ColumnSelection& pSelection, const RowFilterFunc& pRowFilter, TTable& pTable,
+                  const size_t pRowIdx = 0)
+        : mSelection(pSelection)
+        , mRowFilter(pRowFilter)
+        , mTable(pTable)
+        , mRowIdx(pRowIdx)
+        , mColumnIdx(0)
+        , mPendingRows()
+        , mPendingRow()
+        , mRow()
+        , mRowSize(0)
+      {
+      }
+
+      void OnCell(const char* pData, const size_t pLength)
+      {
+        if (!mSelection.IsResolved())
+        {
+          mPendingRow.emplace_back(pData, pLength);
+        }
+        else if (!mSelection.IsActive() || mSelection.IsSelected(mColumnIdx))
+        {
+          if (!mRowFilter || IsLabelRow())
+          {
+            mTable.OnCell(pData, pLength);
+          }
+          else if (mRowSize < mRow.size())
+          {
+            // hold back data row cells until filter decision, reusing strings between rows
+            mRow[mRowSize++].assign(pData, pLength);
+          }
+          else
+          {
+            mRow.emplace_back(pData, pLength);
+            ++mRowSize;
+          }
+        }
+        ++mColumnIdx;
+      }
+
+      void OnRowEnd()
+      {
+        if (!mSelection.IsResolved())
+        {
+          mPendingRows.push_back(mPendingRow);
+          mPendingRow.clear();
+          if (mPendingRows.size() >= mSelection.GetLabelRowCount())
+          {
+            mSelection.Resolve(mPendingRows.back());
+            FlushPendingRows();
+          }
+        }
+        else if (!mRowFilter || IsLabelRow())
+        {
+          mTable.OnRowEnd();
+        }
+        else
+        {
+          mRow.resize(mRowSize);
+          if (mRowFilter(mRow))
+          {
+            for (const auto& cell : mRow)
+            {
+              mTable.OnCell(cell.data(), cell.size());
+            }
+            mTable.OnRowEnd();
+          }
+          mRowSize = 0;
+        }
+
+        if (!mSelection.IsColumnCountChecked() && (mRowIdx == mSelection.GetColumnCountRowIdx()))
+        {
+          mSelection.CheckColumnCount(mColumnIdx);
+        }
+        ++mRowIdx;
+        mColumnIdx = 0;
+      }
+
+      /**
+       * @brief   Returns true while rows up to and including the column label row are parsed.
+       */
+      bool IsLabelRow() const
+      {
+        return mRowIdx < mSelection.GetLabelRowCount();
+      }
+
+      /**
+       * @brief   Complete loading, resolving the selection if no column label row was found.
+       */
+      void Finish()
+      {
+        if (!mSelection.IsResolved())
+        {
+          mSelection.Resolve(std::vector<std::string>());
+          FlushPendingRows();
+        }
+      }
+
+    private:
+      void FlushPendingRows()
+      {
+        for (const auto& row : mPendingRows)
+        {
+          for (size_t columnIdx = 0; columnIdx < row.size(); ++columnIdx)
+          {
+            if (mSelection.IsSelected(columnIdx))
+            {
+              mTable.OnCell(row[columnIdx].data(), row[columnIdx].size());
+            }
+          }
+          mTable.OnRowEnd();
+        }
+        mPendingRows.clear();
+      }
+
+    private:
+      ColumnSelection& mSelection;
+      const RowFilterFunc& mRowFilter;
+      TTable& mTable;
+      size_t mRowIdx;
+      size_t mColumnIdx;
+      std::vector<std::vector<std::string>> mPendingRows;
+      std::vector<std::string> mPendingRow;
+      std::vector<std::string> mRow;
+      size_t mRowSize;
+    };
+
+    /**
+     * @brief   Invokes pFunc for each index in [0, pCount) using up to pThreads threads, including
+     *          the calling thread. The first exception thrown by pFunc is rethrown once all
+     *          threads have completed.
+     */
+    inline void ParallelFor(const size_t pCount, const size_t pThreads, const std::function<void(size_t)>& pFunc)
+    {
+      std::atomic<size_t> next(0);
+      std::exception_ptr error;
+      std::mutex errorMutex;
+      auto worker = [&]()
+      {
+        for (size_t idx = next++; idx < pCount; idx = next++)
+        {
+          try
+          {
+            pFunc(idx);
+          }
+          catch (...)
+          {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error)
+            {
+              error = std::current_exception();
+            }
+          }
+        }
+      };
+
+      std::vector<std::thread> threads;
+      const size_t threadCount = std::min(pCount, pThreads);
+      for (size_t i = 1; i < threadCount; ++i)
+      {
+        try
+        {
+          threads.emplace_back(worker);
+        }
+        catch (const std::system_error&)
+        {
+          // continue with the threads started so far
+          break;
+        }
+      }
+
+      worker();
+      for (auto& thread : threads)
+      {
+        thread.join();
+      }
+
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
+    }
+
+    /**
+     * @brief   Splits data into chunks of approximately equal size at row boundaries. With quoted
+     *          linebreaks enabled, a linebreak is assumed to be quoted if it is preceded by an odd
+     *          number of quote characters. This holds for well-formed data, but is speculative in
+     *          general (a quote character inside an unquoted cell does not start a quoted cell), so
+     *          the caller must verify that each chunk ends at a row boundary.
+     * @param   pData                 data to split.
+     * @param   pLength               length of data.
+     * @param   pChunkCount           requested number of chunks.
+     * @param   pSeparatorParams      separator parameters.
+     * @returns chunk start offsets, followed by pLength.
+     */
+    inline std::vector<size_t> SplitChunks(const char* pData, const size_t pLength, const size_t pChunkCount,
+                                           const SeparatorParams& pSeparatorParams)
+    {
+      std::vector<size_t> splits(pChunkCount + 1);
+      for (size_t i = 0; i <= pChunkCount; ++i)
+      {
+        splits[i] = static_cast<size_t>((static_cast<unsigned long long>(pLength) * i) / pChunkCount);
+      }
+
+      // count quote characters per chunk in parallel to determine quote parity at split points
+      const char quoteChar = pSeparatorParams.mQuoteChar;
+      std::vector<size_t> quoteCounts(pChunkCount, 0);
+      if (pSeparatorParams.mQuotedLinebreaks)
+      {
+        ParallelFor(pChunkCount, pChunkCount, [&](size_t pIdx)
+        {
+          quoteCounts[pIdx] = static_cast<size_t>(std::count(pData + splits[pIdx], pData + splits[pIdx + 1],
+                                                             quoteChar));
+        });
+      }
+
+      std::vector<size_t> offsets(1, 0);
+      size_t quotes = 0;
+      for (size_t i = 1; i < pChunkCount; ++i)
+      {
+        quotes += quoteCounts[i - 1];
+        if (offsets.back() >= splits[i])
+        {
+          // previous chunk extends beyond this split point
+          continue;
+        }
+
+        const char* pos = pData + splits[i];
+        const char* const end = pData + pLength;
+        if (pSeparatorParams.mQuotedLinebreaks)
+        {
+          bool quoted = ((quotes % 2) != 0);
+          for ( ; pos < end; ++pos)
+          {
+            if (*pos == quoteChar)
+            {
+              quoted = !quoted;
+            }
+            else if ((*pos == '\n') && !quoted)
+            {
+              break;
+            }
+          }
+        }
+        else
+        {
+          pos = static_cast<const char*>(std::memchr(pos, '\n', static_cast<size_t>(end - pos)));
+          if (pos == nullptr)
+          {
+            pos = end;
+          }
+        }
+
+        const size_t offset = static_cast<size_t>(pos - pData) + 1;
+        if (offset >= pLength)
+        {
+          break;
+        }
+
+        offsets.push_back(offset);
+      }
+
+      offsets.push_back(pLength);
+      return offsets;
+    }
+
+#ifdef RAPIDCSV_HAS_MMAP
+    /**
+     * @brief   Read-only memory mapping of a regular file.
+     */
+    class MappedFile
+    {
+    public:
+      MappedFile()
+        : mData(nullptr)
+        , mSize(0)
+      {
+      }
+
+      ~MappedFile()
+      {
+        if (mData != nullptr)
+        {
+          munmap(const_cast<char*>(mData), mSize);
+        }
+      }
+
+      MappedFile(const MappedFile&) = delete;
+      MappedFile& operator=(const MappedFile&) = delete;
+
+      /**
+       * @brief   Map file.
+       * @param   pPath               path of file to map.
+       * @returns true on success, false if the file could not be opened, is not a regular file,
+       *          or could not be mapped.
+       */
+      bool Open(const std::string& pPath)
+      {
+        // opening a pipe would block until it has a writer and discard data on close, so
+        // non-regular files are left to the stream fallback without being opened here
+        struct stat st;
+        if ((stat(pPath.c_str(), &st) != 0) || !S_ISREG(st.st_mode))
+        {
+          return false;
+        }
+
+        const int fd = open(pPath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+          return false;
+        }
+
+        bool rv = false;
+        if ((fstat(fd, &st) == 0) && S_ISREG(st.st_mode))
+        {
+          mSize = static_cast<size_t>(st.st_size);
+          if (mSize == 0)
+          {
+            // nothing to map
+            rv = true;
+          }
+          else
+          {
+            void* addr = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED)
+            {
+              madvise(addr, mSize, MADV_SEQUENTIAL);
+              mData = static_cast<const char*>(addr);
+              rv = true;
+            }
+          }
+        }
+
+        close(fd);
+        return rv;
+      }
+
+      const char* GetData() const
+      {
+        return mData;
+      }
+
+      size_t GetSize() const
+      {
+        return mSize;
+      }
+
+    private:
+      const char* mData;
+      size_t mSize;
+    };
+
+    /**
+     * @brief   Output file supporting positioned writes from multiple threads. Errors are
+     *          reported as std::ios_base::failure, as for file streams.
+     */
+    class OutputFile
+    {
+    public:
+      OutputFile()
+        : mFd(-1)
+      {
+      }
+
+      ~OutputFile()
+      {
+        if (mFd >= 0)
+        {
+          close(mFd);
+        }
+      }
+
+      OutputFile(const OutputFile&) = delete;
+      OutputFile& operator=(const OutputFile&) = delete;
+
+      /**
+       * @brief   Create file, or truncate an existing file.
+       * @param   pPath               path of file to create.
+       */
+      void Create(const std::string& pPath)
+      {
+        mFd = open(pPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+        if (mFd < 0)
+        {
+          ThrowError("open " + pPath);
+        }
+      }
+
+      /**
+       * @brief   Write data at a file offset.
+       * @param   pData               data to write.
+       * @param   pLength             length of data.
+       * @param   pOffset             file offset.
+       */
+      void WriteAt(const char* pData, size_t pLength, size_t pOffset) const
+      {
+        while (pLength > 0)
+        {
+          const ssize_t written = pwrite(mFd, pData, pLength, static_cast<off_t>(pOffset));
+          if (written < 0)
+          {
+            if (errno == EINTR)
+            {
+              continue;
+            }
+            ThrowError("pwrite");
+          }
+
+          const size_t length = static_cast<size_t>(written);
+          pData += length;
+          pLength -= length;
+          pOffset += length;
+        }
+      }
+
+      void Close()
+      {
+        const int fd = mFd;
+        mFd = -1;
+        if (close(fd) != 0)
+        {
+          ThrowError("close");
+        }
+      }
+
+    private:
+      static void ThrowError(const std::string& pWhat)
+      {
+        throw std::ios_base::failure(pWhat, std::error_code(errno, std::generic_category()));
+      }
+
+    private:
+      int mFd;
+    };
+#endif
+
+    /**
+     * @brief   Returns path of a temporary file in the same directory as pPath, unique per call
+     *          within the process, so concurrent saves of the same file do not collide.
+     */
+    inline std::string GetTempPath(const std::string& pPath)
+    {
+      static std::atomic<unsigned> sCounter(0);
+      const std::string suffix = "." + std::to_string(sCounter++);
+#ifdef RAPIDCSV_HAS_MMAP
+      return pPath + ".tmp" + std::to_string(getpid()) + suffix;
+#else
+      return pPath + ".tmp" + suffix;
+#endif
+    }
+
+    /**
+     * @brief   Renames pFrom to pTo, replacing any existing file. Atomic on POSIX platforms,
+     *          where pFrom first gets the permission bits of an existing pTo.
+     */
+    inline void ReplaceFile(const std::string& pFrom, const std::string& pTo)
+    {
+#ifdef RAPIDCSV_HAS_MMAP
+      struct stat toStat;
+      if ((stat(pTo.c_str(), &toStat) == 0) &&
+          (chmod(pFrom.c_str(), toStat.st_mode & static_cast<mode_t>(07777)) != 0))
+      {
+        throw std::ios_base::failure("chmod " + pFrom, std::error_code(errno, std::generic_category()));
+      }
+#else
+      // rename does not replace an existing file on all platforms
+      std::remove(pTo.c_str());
+#endif
+      if (std::rename(pFrom.c_str(), pTo.c_str()) != 0)
+      {
+        throw std::ios_base::failure("rename " + pFrom + " to " + pTo,
+                                     std::error_code(errno, std::generic_category()));
+      }
+    }
+
+    /**
+     * @brief   Flushes a file, or the entries of a directory, to storage. No-op on platforms
+     *          without fsync.
+     */
+    inline void SyncPath(const std::string& pPath)
+    {
+#ifdef RAPIDCSV_HAS_MMAP
+      const int fd = open(pPath.c_str(), O_RDONLY | O_CLOEXEC);
+      if ((fd < 0) || (fsync(fd) != 0))
+      {
+        const int err = errno;
+        if (fd >= 0)
+        {
+          close(fd);
+        }
+        throw std::ios_base::failure("fsync " + pPath, std::error_code(err, std::generic_category()));
+      }
+      close(fd);
+#else
+      (void)pPath;
+#endif
+    }
+
+    /**
+     * @brief   Returns the directory part of pPath, or "." if it has none.
+     */
+    inline std::string GetDirPath(const std::string& pPath)
+    {
+      const size_t pos = pPath.find_last_of("/\\");
+      if (pos == std::string::npos)
+      {
+        return ".";
+      }
+      return (pos == 0) ? pPath.substr(0, 1) : pPath.substr(0, pos);
+    }
+
+    /**
+     * @brief   Gets the size and modification time (in nanoseconds) of a file.
+     * @returns true on success, false if the file does not exist or the platform is not supported.
+     */
+    inline bool GetFileStamp(const std::string& pPath, int64_t& pSize, int64_t& pTime)
+    {
+#ifdef RAPIDCSV_HAS_MMAP
+      struct stat st;
+      if (stat(pPath.c_str(), &st) != 0)
+      {
+        return false;
+      }
+
+      pSize = static_cast<int64_t>(st.st_size);
+#ifdef __APPLE__
+      pTime = (static_cast<int64_t>(st.st_mtimespec.tv_sec) * 1000000000) + st.st_mtimespec.tv_nsec;
+#else
+      pTime = (static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000) + st.st_mtim.tv_nsec;
+#endif
+      return true;
+#else
+      (void)pPath;
+      (void)pSize;
+      (void)pTime;
+      return false;
+#endif
+    }
+
+    /**
+     * @brief   Converted column data held by the Document column cache.
+     */
+    class ColumnCacheEntry
+    {
+    public:
+      virtual ~ColumnCacheEntry()
+      {
+      }
+    };
+
+    template<typename T>
+    class TypedColumnCacheEntry : public ColumnCacheEntry
+    {
+    public:
+      explicit TypedColumnCacheEntry(std::vector<T>&& pColumn)
+        : mColumn(std::move(pColumn))
+      {
+      }
+
+      const std::vector<T>& GetColumn() const
+      {
+        return mColumn;
+      }
+
+    private:
+      std::vector<T> mColumn;
+    };
+  }
+
+  class Document;
+
+  /**
+   * @brief     Column resolved to its storage index, with a bound converter, for repeated
+   *            cell access through Document::GetCell(). Obtained by Document::GetColumnHandle().
+   *            A handle keeps a copy of the converter parameters and locale properties of its
+   *            Document at that time, so it does not refer to the Document, but it is
+   *            invalidated when the Document is reloaded or columns are inserted or removed.
+   *            Handles can be copied and assigned, e.g. to resolve a handle again.
+   */
+  template<typename T>
+  class ColumnHandle
+  {
+  public:
+    /**
+     * @brief   Get the zero-based column index that the handle was resolved to.
+     * @returns column index.
+     */
+    size_t GetColumnIdx() const
+    {
+      return mColumnIdx;
+    }
+
+  private:
+    friend class Document;
+
+    ColumnHandle(const size_t pColumnIdx, const size_t pDataColumnIdx,
+                 const ConverterParams& pConverterParams,
+                 const detail::NumericLocale& pNumericLocale)
+      : mColumnIdx(pColumnIdx)
+      , mDataColumnIdx(pDataColumnIdx)
+      , mConverter(pConverterParams, pNumericLocale)
+    {
+    }
+
+    size_t mColumnIdx;
+    size_t mDataColumnIdx;
+    Converter<T> mConverter;
+  };
+
+  /**
+   * @brief     Row resolved to its storage index, for repeated cell access through
+   *            Document::GetCell(). Obtained by Document::GetRowHandle(). A handle is
+   *            invalidated when the Document is reloaded or rows are inserted or removed.
+   */
+  class RowHandle
+  {
+  public:
+    /**
+     * @brief   Get the zero-based row index that the handle was resolved to.
+     * @returns row index.
+     */
+    size_t GetRowIdx() const
+    {
+      return mRowIdx;
+    }
+
+  private:
+    friend class Document;
+
+    RowHandle(const size_t pRowIdx, const size_t pDataRowIdx)
+      : mRowIdx(pRowIdx)
+      , mDataRowIdx(pDataRowIdx)
+    {
+    }
+
+    size_t mRowIdx;
+    size_t mDataRowIdx;
+  };
+
+  /**
+   * @brief     Class representing a CSV document.
+   */
+  class Document
+  {
+  public:
+    /**
+     * @brief   Constructor
+     * @param   pPath                 specifies the path of an existing CSV-file to populate the Document
+     *                                data with.
+     * @param   pLabelParams          specifies which row and column should be treated as labels.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
+     *                                handled.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @param   pLoadParams           specifies how CSV data should be loaded.
+     */
+    explicit Document(const std::string& pPath = std::string(),
+                      const LabelParams& pLabelParams = LabelParams(),
+                      const SeparatorParams& pSeparatorParams = SeparatorParams(),
+                      const ConverterParams& pConverterParams = ConverterParams(),
+                      const LineReaderParams& pLineReaderParams = LineReaderParams(),
+                      const LoadParams& pLoadParams = LoadParams())
+      : mPath(pPath)
+      , mLabelParams(pLabelParams)
+      , mSeparatorParams(pSeparatorParams)
+      , mConverterParams(pConverterParams)
+      , mNumericLocale()
+      , mLineReaderParams(pLineReaderParams)
+      , mLoadParams(pLoadParams)
+      , mData()
+      , mArena()
+      , mColumnCache()
+      , mColumnNames()
+      , mRowNames()
+      , mSavedPath()
+      , mSavedRowCount(0)
+      , mSavedSize(-1)
+      , mSavedTime(0)
+      , mColumnCapacity(0)
+    {
+      if (!mPath.empty())
+      {
+        ReadCsv();
+      }
+    }
+
+    /**
+     * @brief   Constructor
+     * @param   pStream               specifies a binary input stream to read CSV data from.
+     * @param   pLabelParams          specifies which row and column should be treated as labels.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
+     *                                handled.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @param   pLoadParams           specifies how CSV data should be loaded.
+     */
+    explicit Document(std::istream& pStream,
+                      const LabelParams& pLabelParams = LabelParams(),
+                      const SeparatorParams& pSeparatorParams = SeparatorParams(),
+                      const ConverterParams& pConverterParams = ConverterParams(),
+                      const LineReaderParams& pLineReaderParams = LineReaderParams(),
+                      const LoadParams& pLoadParams = LoadParams())
+      : mPath()
+      , mLabelParams(pLabelParams)
+      , mSeparatorParams(pSeparatorParams)
+      , mConverterParams(pConverterParams)
+      , mNumericLocale()
+      , mLineReaderParams(pLineReaderParams)
+      , mLoadParams(pLoadParams)
+      , mData()
+      , mArena()
+      , mColumnCache()
+      , mColumnNames()
+      , mRowNames()
+      , mSavedPath()
+      , mSavedRowCount(0)
+      , mSavedSize(-1)
+      , mSavedTime(0)
+      , mColumnCapacity(0)
+    {
+      ReadCsv(pStream);
+    }
+
+    /**
+     * @brief   Read Document data from file.
+     * @param   pPath                 specifies the path of an existing CSV-file to populate the Document
+     *                                data with.
+     * @param   pLabelParams          specifies which row and column should be treated as labels.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
+     *                                handled.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @param   pLoadParams           specifies how CSV data should be loaded.
+     */
+    void Load(const std::string& pPath,
+              const LabelParams& pLabelParams = LabelParams(),
+              const SeparatorParams& pSeparatorParams = SeparatorParams(),
+              const ConverterParams& pConverterParams = ConverterParams(),
+              const LineReaderParams& pLineReaderParams = LineReaderParams(),
+              const LoadParams& pLoadParams = LoadParams())
+    {
+      mPath = pPath;
+      mLabelParams = pLabelParams;
+      mSeparatorParams = pSeparatorParams;
+      mConverterParams = pConverterParams;
+      mNumericLocale = detail::NumericLocale();
+      mLineReaderParams = pLineReaderParams;
+      mLoadParams = pLoadParams;
+      ReadCsv();
+    }
+
+    /**
+     * @brief   Read Document data from stream.
+     * @param   pStream               specifies a binary input stream to read CSV data from.
+     * @param   pLabelParams          specifies which row and column should be treated as labels.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
+     *                                handled.
      * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @param   pLoadParams           specifies how CSV data should be loaded.
+     */
+    void Load(std::istream& pStream,
+              const LabelParams& pLabelParams = LabelParams(),
+              const SeparatorParams& pSeparatorParams = SeparatorParams(),
+              const ConverterParams& pConverterParams = ConverterParams(),
+              const LineReaderParams& pLineReaderParams = LineReaderParams(),
+              const LoadParams& pLoadParams = LoadParams())
+    {
+      mPath = "";
+      mLabelParams = pLabelParams;
+      mSeparatorParams = pSeparatorParams;
+      mConverterParams = pConverterParams;
+      mNumericLocale = detail::NumericLocale();
+      mLineReaderParams = pLineReaderParams;
+      mLoadParams = pLoadParams;
+      ReadCsv(pStream);
+    }
+
+    /**
+     * @brief   Write Document data to file.
+     * @param   pPath                 optionally specifies the path where the CSV-file will be created
+     *                                (if not specified, the original path provided when creating or
+     *                                loading the Document data will be used).
+     */
+    void Save(const std::string& pPath = std::string())
+    {
+      Save(pPath, SaveParams());
+    }
+
+    /**
+     * @brief   Write Document data to file.
+     * @param   pPath                 specifies the path where the CSV-file will be created (if
+     *                                empty, the original path provided when creating or loading
+     *                                the Document data will be used).
+     * @param   pSaveParams           specifies how CSV data should be saved.
+     */
+    void Save(const std::string& pPath, const SaveParams& pSaveParams)
+    {
+      if (!pPath.empty())
+      {
+        mPath = pPath;
+      }
+
+      if (!pSaveParams.mAppend || !AppendCsv())
+      {
+        WriteCsv(pSaveParams);
+      }
+
+      SetSaved();
+    }
+
+    /**
+     * @brief   Write Document data to stream.
+     * @param   pStream               specifies a binary output stream to write the data to.
+     * @param   pSaveParams           specifies how CSV data should be saved.
+     */
+    void Save(std::ostream& pStream, const SaveParams& pSaveParams = SaveParams()) const
+    {
+      WriteCsv(pStream, pSaveParams);
+    }
+
+    /**
+     * @brief   Reserve storage for a number of rows and columns, avoiding repeated reallocations
+     *          when building a Document by adding rows, columns or cells.
+     * @param   pRowCount             number of data rows to reserve storage for.
+     * @param   pColumnCount          number of data columns to reserve storage for in each row
+     *                                (optional argument).
+     */
+    void Reserve(const size_t pRowCount, const size_t pColumnCount = 0)
+    {
+      MakeMutable();
+      mData.reserve(GetDataRowIndex(pRowCount));
+      if (pColumnCount > 0)
+      {
+        mColumnCapacity = GetDataColumnIndex(pColumnCount);
+        for (auto& row : mData)
+        {
+          row.reserve(mColumnCapacity);
+        }
+      }
+    }
+
+    /**
+     * @brief   Clears loaded Document data.
+     *
+     */
+    void Clear()
+    {
+      mData.clear();
+      mArena.Clear();
+      mColumnCache.clear();
+      mColumnNames.Clear();
+      mRowNames.Reset();
+      mSavedPath.clear();
+      mSavedRowCount = 0;
+      mColumnCapacity = 0;
+#ifdef HAS_CODECVT
+      mIsUtf16 = false;
+      mIsLE = false;
+#endif
+      mHasUtf8BOM = false;
+    }
+
+    /**
+     * @brief   Get column index by name.
+     * @param   pColumnName           column label name.
+     * @returns zero-based column index.
+     */
+    int GetColumnIdx(const std::string& pColumnName) const
+    {
+      if (mLabelParams.mColumnNameIdx >= 0)
+      {
+        size_t columnIdx = 0;
+        if (mColumnNames.Find(pColumnName, columnIdx))
+        {
+          return static_cast<int>(columnIdx) - (mLabelParams.mRowNameIdx + 1);
+        }
+      }
+      return -1;
+    }
+
+    /**
+     * @brief   Get column by index.
+     * @param   pColumnIdx            zero-based column index.
+     * @returns vector of column data.
+     */
+    template<typename T>
+    std::vector<T> GetColumn(const size_t pColumnIdx) const
+    {
+      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
+      std::vector<T> column;
+      Converter<T> converter(mConverterParams, mNumericLocale);
+      std::string buffer;
+      const size_t rowCount = GetDataRowCount();
+      for (size_t dataRowIdx = GetDataRowIndex(0); dataRowIdx < rowCount; ++dataRowIdx)
+      {
+        const size_t rowSize = GetDataRowSize(dataRowIdx);
+        if (dataColumnIdx < rowSize)
+        {
+          T val;
+          converter.ToVal(GetDataCell(dataRowIdx, dataColumnIdx, buffer), val);
+          column.push_back(val);
+        }
+        else
+        {
+          const std::string errStr = "requested column index " +
+            std::to_string(pColumnIdx) + " >= " +
+            std::to_string(rowSize - GetDataColumnIndex(0)) +
+            " (number of columns on row index " +
+            std::to_string(static_cast<int>(dataRowIdx) -
+                           (mLabelParams.mColumnNameIdx + 1)) + ")";
+          throw std::out_of_range(errStr);
+        }
+      }
+      return column;
+    }
+
+    /**
+     * @brief   Get column by index.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pToVal                conversion function.
+     * @returns vector of column data.
+     */
+    template<typename T>
+    std::vector<T> GetColumn(const size_t pColumnIdx, ConvFunc<T> pToVal) const
+    {
+      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
+      std::vector<T> column;
+      std::string buffer;
+      const size_t rowCount = GetDataRowCount();
+      for (size_t dataRowIdx = GetDataRowIndex(0); dataRowIdx < rowCount; ++dataRowIdx)
+      {
+        T val;
+        pToVal(GetDataCell(dataRowIdx, dataColumnIdx, buffer), val);
+        column.push_back(val);
+      }
+      return column;
+    }
+
+    /**
+     * @brief   Get column by name.
+     * @param   pColumnName           column label name.
+     * @returns vector of column data.
+     */
+    template<typename T>
+    std::vector<T> GetColumn(const std::string& pColumnName) const
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+      return GetColumn<T>(static_cast<size_t>(columnIdx));
+    }
+
+    /**
+     * @brief   Get column by name.
+     * @param   pColumnName           column label name.
+     * @param   pToVal                conversion function.
+     * @returns vector of column data.
+     */
+    template<typename T>
+    std::vector<T> GetColumn(const std::string& pColumnName, ConvFunc<T> pToVal) const
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+      return GetColumn<T>(static_cast<size_t>(columnIdx), pToVal);
+    }
+
+    /**
+     * @brief   Get column by index, converted once and cached. Repeated calls for the same
+     *          column and datatype return the cached data until it is invalidated by a
+     *          modification of the column (or of rows, or columns before it), or by loading or
+     *          clearing the Document.
+     * @param   pColumnIdx            zero-based column index.
+     * @returns reference to the column data, valid until the cached column is invalidated.
+     */
+    template<typename T>
+    const std::vector<T>& GetColumnCached(const size_t pColumnIdx)
+    {
+      const std::pair<size_t, std::type_index> key(pColumnIdx, std::type_index(typeid(T)));
+      auto itEntry = mColumnCache.find(key);
+      if (itEntry == mColumnCache.end())
+      {
+        const std::shared_ptr<detail::ColumnCacheEntry> entry =
+          std::make_shared<detail::TypedColumnCacheEntry<T>>(GetColumn<T>(pColumnIdx));
+        itEntry = mColumnCache.insert(std::make_pair(key, entry)).first;
+      }
+
+      return static_cast<const detail::TypedColumnCacheEntry<T>&>(*itEntry->second).GetColumn();
+    }
+
+    /**
+     * @brief   Get column by name, converted once and cached.
+     * @param   pColumnName           column label name.
+     * @returns reference to the column data, valid until the cached column is invalidated.
+     */
+    template<typename T>
+    const std::vector<T>& GetColumnCached(const std::string& pColumnName)
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+      return GetColumnCached<T>(static_cast<size_t>(columnIdx));
+    }
+
+    /**
+     * @brief   Set column by index.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pColumn               vector of column data.
+     */
+    template<typename T>
+    void SetColumn(const size_t pColumnIdx, const std::vector<T>& pColumn)
+    {
+      const size_t dataColumnIdx = PrepareColumn(pColumnIdx, pColumn.size());
+      Converter<T> converter(mConverterParams, mNumericLocale);
+      for (auto itRow = pColumn.begin(); itRow != pColumn.end(); ++itRow)
+      {
+        std::string str;
+        converter.ToStr(*itRow, str);
+        mData.at(static_cast<size_t>(std::distance(pColumn.begin(), itRow) + mLabelParams.mColumnNameIdx + 1)).at(
+          dataColumnIdx) = std::move(str);
+      }
+    }
+
+    /**
+     * @brief   Set column by index, moving the strings into the Document.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pColumn               vector of column data.
+     */
+    void SetColumn(const size_t pColumnIdx, std::vector<std::string>&& pColumn)
+    {
+      const size_t dataColumnIdx = PrepareColumn(pColumnIdx, pColumn.size());
+      for (size_t i = 0; i < pColumn.size(); ++i)
+      {
+        mData.at(GetDataRowIndex(i)).at(dataColumnIdx) = std::move(pColumn[i]);
+      }
+      pColumn.clear();
+    }
+
+    /**
+     * @brief   Set column by name.
+     * @param   pColumnName           column label name.
+     * @param   pColumn               vector of column data.
+     */
+    template<typename T>
+    void SetColumn(const std::string& pColumnName, const std::vector<T>& pColumn)
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+      SetColumn<T>(static_cast<size_t>(columnIdx), pColumn);
+    }
+
+    /**
+     * @brief   Set column by name, moving the strings into the Document.
+     * @param   pColumnName           column label name.
+     * @param   pColumn               vector of column data.
+     */
+    void SetColumn(const std::string& pColumnName, std::vector<std::string>&& pColumn)
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+      SetColumn(static_cast<size_t>(columnIdx), std::move(pColumn));
+    }
+
+    /**
+     * @brief   Remove column by index.
+     * @param   pColumnIdx            zero-based column index.
+     */
+    void RemoveColumn(const size_t pColumnIdx)
+    {
+      MakeMutable();
+      SetModified(0);
+      InvalidateColumnCache(pColumnIdx, true);
+      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
+      for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
+      {
+        if (std::distance(mData.begin(), itRow) >= mLabelParams.mColumnNameIdx)
+        {
+          if (dataColumnIdx < itRow->size())
+          {
+            itRow->erase(itRow->begin() + static_cast<int>(dataColumnIdx));
+          }
+          else
+          {
+            const std::string errStr = "column out of range: " +
+              std::to_string(pColumnIdx) + " (on row " +
+              std::to_string(std::distance(mData.begin(), itRow)) +
+              ")";
+            throw std::out_of_range(errStr);
+          }
+        }
+      }
+
+      UpdateColumnNames();
+    }
+
+    /**
+     * @brief   Remove column by name.
+     * @param   pColumnName           column label name.
+     */
+    void RemoveColumn(const std::string& pColumnName)
+    {
+      int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+
+      RemoveColumn(static_cast<size_t>(columnIdx));
+    }
+
+    /**
+     * @brief   Remove multiple columns by index, in a single pass over the rows.
+     * @param   pColumnIdxs           zero-based column indices, in any order.
+     */
+    void RemoveColumns(const std::vector<size_t>& pColumnIdxs)
+    {
+      if (pColumnIdxs.empty())
+      {
+        return;
+      }
+
+      std::vector<bool> remove;
+      for (const size_t columnIdx : pColumnIdxs)
+      {
+        const size_t dataColumnIdx = GetDataColumnIndex(columnIdx);
+        if (dataColumnIdx >= remove.size())
+        {
+          remove.resize(dataColumnIdx + 1);
+        }
+        remove[dataColumnIdx] = true;
+      }
+
+      RemoveDataColumns(remove);
+    }
+
+    /**
+     * @brief   Remove all columns for which a predicate returns true, in a single pass over
+     *          the rows.
+     * @param   pPredicate            function called with each zero-based column index.
+     */
+    template<typename TPredicate>
+    void RemoveColumnsIf(TPredicate pPredicate)
+    {
+      std::vector<bool> remove(GetDataColumnIndex(0));
+      const size_t columnCount = GetColumnCount();
+      for (size_t columnIdx = 0; columnIdx < columnCount; ++columnIdx)
+      {
+        remove.push_back(pPredicate(columnIdx));
+      }
+
+      RemoveDataColumns(remove);
+    }
+
+    /**
+     * @brief   Insert column at specified index.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pColumn               vector of column data (optional argument).
+     * @param   pColumnName           column label name (optional argument).
+     */
+    template<typename T>
+    void InsertColumn(const size_t pColumnIdx, const std::vector<T>& pColumn = std::vector<T>(),
+                      const std::string& pColumnName = std::string())
+    {
+      MakeMutable();
+      SetModified(0);
+      InvalidateColumnCache(pColumnIdx, true);
+      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
+
+      std::vector<std::string> column;
+      if (pColumn.empty())
+      {
+        column.resize(GetDataRowCount());
+      }
+      else
+      {
+        column.resize(GetDataRowIndex(pColumn.size()));
+        Converter<T> converter(mConverterParams, mNumericLocale);
+        for (auto itRow = pColumn.begin(); itRow != pColumn.end(); ++itRow)
+        {
+          std::string str;
+          converter.ToStr(*itRow, str);
+          const size_t rowIdx =
+            static_cast<size_t>(std::distance(pColumn.begin(), itRow) + (mLabelParams.mColumnNameIdx + 1));
+          column.at(rowIdx) = str;
+        }
+      }
+
+      while (column.size() > GetDataRowCount())
+      {
+        InvalidateColumnCache();
+        const size_t columnCount = std::max<size_t>(static_cast<size_t>(mLabelParams.mColumnNameIdx + 1),
+                                                    GetDataColumnCount());
+        mData.push_back(MakeEmptyRow(columnCount));
+      }
+
+      for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
+      {
+        if (std::distance(mData.begin(), itRow) >= mLabelParams.mColumnNameIdx)
+        {
+          const size_t rowIdx = static_cast<size_t>(std::distance(mData.begin(), itRow));
+          if (dataColumnIdx <= itRow->size())
+          {
+            itRow->insert(itRow->begin() + static_cast<int>(dataColumnIdx), column.at(rowIdx));
+          }
+          else
+          {
+            const std::string errStr = "column out of range: " +
+              std::to_string(pColumnIdx) + " (on row " +
+              std::to_string(std::distance(mData.begin(), itRow)) +
+              ")";
+            throw std::out_of_range(errStr);
+          }
+        }
+      }
+
+      if (!pColumnName.empty())
+      {
+        SetColumnName(pColumnIdx, pColumnName);
+      }
+
+      UpdateColumnNames();
+    }
+
+    /**
+     * @brief   Get number of data columns (excluding label columns).
+     * @returns column count.
+     */
+    size_t GetColumnCount() const
+    {
+      const size_t firstRow = static_cast<size_t>((mLabelParams.mColumnNameIdx >= 0) ? mLabelParams.mColumnNameIdx : 0);
+      const int count = static_cast<int>((GetDataRowCount() > firstRow) ? GetDataRowSize(firstRow) : 0) -
+        (mLabelParams.mRowNameIdx + 1);
+      return (count >= 0) ? static_cast<size_t>(count) : 0;
+    }
+
+    /**
+     * @brief   Get row index by name.
+     * @param   pRowName              row label name.
+     * @returns zero-based row index.
+     */
+    int GetRowIdx(const std::string& pRowName) const
+    {
+      if (mLabelParams.mRowNameIdx >= 0)
+      {
+        const detail::LabelIndex& rowNames =
+          mRowNames.Get([this](detail::LabelIndex& pIndex) { BuildRowNames(pIndex); });
+        size_t rowIdx = 0;
+        if (rowNames.Find(pRowName, rowIdx))
+        {
+          return static_cast<int>(rowIdx) - (mLabelParams.mColumnNameIdx + 1);
+        }
+      }
+      return -1;
+    }
+
+    /**
+     * @brief   Get row by index.
+     * @param   pRowIdx               zero-based row index.
+     * @returns vector of row data.
+     */
+    template<typename T>
+    std::vector<T> GetRow(const size_t pRowIdx) const
+    {
+      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+      std::vector<T> row;
+      Converter<T> converter(mConverterParams, mNumericLocale);
+      std::string buffer;
+      const size_t rowSize = GetDataRowSize(dataRowIdx);
+      for (size_t dataColumnIdx = GetDataColumnIndex(0); dataColumnIdx < rowSize; ++dataColumnIdx)
+      {
+        T val;
+        converter.ToVal(GetDataCell(dataRowIdx, dataColumnIdx, buffer), val);
+        row.push_back(val);
+      }
+      return row;
+    }
+
+    /**
+     * @brief   Get row by index.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pToVal                conversion function.
+     * @returns vector of row data.
+     */
+    template<typename T>
+    std::vector<T> GetRow(const size_t pRowIdx, ConvFunc<T> pToVal) const
+    {
+      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+      std::vector<T> row;
+      std::string buffer;
+      const size_t rowSize = GetDataRowSize(dataRowIdx);
+      for (size_t dataColumnIdx = GetDataColumnIndex(0); dataColumnIdx < rowSize; ++dataColumnIdx)
+      {
+        T val;
+        pToVal(GetDataCell(dataRowIdx, dataColumnIdx, buffer), val);
+        row.push_back(val);
+      }
+      return row;
+    }
+
+    /**
+     * @brief   Get row by name.
+     * @param   pRowName              row label name.
+     * @returns vector of row data.
+     */
+    template<typename T>
+    std::vector<T> GetRow(const std::string& pRowName) const
+    {
+      int rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+      return GetRow<T>(static_cast<size_t>(rowIdx));
+    }
+
+    /**
+     * @brief   Get row by name.
+     * @param   pRowName              row label name.
+     * @param   pToVal                conversion function.
+     * @returns vector of row data.
+     */
+    template<typename T>
+    std::vector<T> GetRow(const std::string& pRowName, ConvFunc<T> pToVal) const
+    {
+      int rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+      return GetRow<T>(static_cast<size_t>(rowIdx), pToVal);
+    }
+
+    /**
+     * @brief   Set row by index.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pRow                  vector of row data.
+     */
+    template<typename T>
+    void SetRow(const size_t pRowIdx, const std::vector<T>& pRow)
+    {
+      MakeMutable();
+      InvalidateColumnCache();
+      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+      SetModified((pRow.size() > GetDataColumnCount()) ? 0 : dataRowIdx);
+
+      while ((dataRowIdx + 1) > GetDataRowCount())
+      {
+        mData.push_back(MakeEmptyRow(GetDataColumnCount()));
+      }
+
+      if (pRow.size() > GetDataColumnCount())
+      {
+        for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
+        {
+          if (std::distance(mData.begin(), itRow) >= mLabelParams.mColumnNameIdx)
+          {
+            itRow->resize(GetDataColumnIndex(pRow.size()));
+          }
+        }
+      }
+
+      Converter<T> converter(mConverterParams, mNumericLocale);
+      for (auto itCol = pRow.begin(); itCol != pRow.end(); ++itCol)
+      {
+        std::string str;
+        converter.ToStr(*itCol, str);
+        mData.at(dataRowIdx).at(static_cast<size_t>(std::distance(pRow.begin(),
+                                                                  itCol) + mLabelParams.mRowNameIdx + 1)) = str;
+      }
+    }
+
+    /**
+     * @brief   Set row by name.
+     * @param   pRowName              row label name.
+     * @param   pRow                  vector of row data.
+     */
+    template<typename T>
+    void SetRow(const std::string& pRowName, const std::vector<T>& pRow)
+    {
+      int rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+      return SetRow<T>(static_cast<size_t>(rowIdx), pRow);
+    }
+
+    /**
+     * @brief   Remove row by index.
+     * @param   pRowIdx               zero-based row index.
+     */
+    void RemoveRow(const size_t pRowIdx)
+    {
+      MakeMutable();
+      InvalidateColumnCache();
+      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+      if (dataRowIdx < mData.size())
+      {
+        SetModified(dataRowIdx);
+        RemoveRowName(dataRowIdx);
+        mData.erase(mData.begin() + static_cast<int>(dataRowIdx));
+      }
+      else
+      {
+        const std::string errStr = "row out of range: " +
+          std::to_string(pRowIdx);
+        throw std::out_of_range(errStr);
+      }
+    }
+
+    /**
+     * @brief   Remove row by name.
+     * @param   pRowName              row label name.
+     */
+    void RemoveRow(const std::string& pRowName)
+    {
+      int rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+
+      RemoveRow(static_cast<size_t>(rowIdx));
+    }
+
+    /**
+     * @brief   Remove multiple rows by index, compacting the remaining rows in a single pass.
+     * @param   pRowIdxs              zero-based row indices, in any order.
+     */
+    void RemoveRows(const std::vector<size_t>& pRowIdxs)
+    {
+      if (pRowIdxs.empty())
+      {
+        return;
+      }
+
+      std::vector<bool> remove(GetDataRowCount());
+      for (const size_t rowIdx : pRowIdxs)
+      {
+        const size_t dataRowIdx = GetDataRowIndex(rowIdx);
+        if (dataRowIdx >= remove.size())
+        {
+          throw std::out_of_range("row out of range: " + std::to_string(rowIdx));
+        }
+        remove[dataRowIdx] = true;
+      }
+
+      RemoveDataRows(remove);
+    }
+
+    /**
+     * @brief   Remove all rows for which a predicate returns true, compacting the remaining
+     *          rows in a single pass.
+     * @param   pPredicate            function called with each zero-based row index.
+     */
+    template<typename TPredicate>
+    void RemoveRowsIf(TPredicate pPredicate)
+    {
+      std::vector<bool> remove(GetDataRowIndex(0));
+      const size_t rowCount = GetRowCount();
+      for (size_t rowIdx = 0; rowIdx < rowCount; ++rowIdx)
+      {
+        remove.push_back(pPredicate(rowIdx));
+      }
+
+      RemoveDataRows(remove);
+    }
+
+    /**
+     * @brief   Insert row at specified index.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pRow                  vector of row data (optional argument).
+     * @param   pRowName              row label name (optional argument).
+     */
+    template<typename T>
+    void InsertRow(const size_t pRowIdx, const std::vector<T>& pRow = std::vector<T>(),
+                   const std::string& pRowName = std::string())
+    {
+      std::vector<std::string> row;
+      if (pRow.empty())
+      {
+        row.resize(GetDataColumnCount());
+      }
+      else
+      {
+        row.resize(GetDataColumnIndex(pRow.size()));
+        Converter<T> converter(mConverterParams, mNumericLocale);
+        for (auto itCol = pRow.begin(); itCol != pRow.end(); ++itCol)
+        {
+          std::string str;
+          converter.ToStr(*itCol, str);
+          row.at(static_cast<size_t>(std::distance(pRow.begin(), itCol) + mLabelParams.mRowNameIdx + 1)) =
+            std::move(str);
+        }
+      }
+
+      InsertDataRow(pRowIdx, std::move(row), pRowName);
+    }
+
+    /**
+     * @brief   Insert row at specified index, moving the strings into the Document.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pRow                  vector of row data.
+     * @param   pRowName              row label name (optional argument).
+     */
+    void InsertRow(const size_t pRowIdx, std::vector<std::string>&& pRow,
+                   const std::string& pRowName = std::string())
+    {
+      InsertDataRow(pRowIdx, MakeDataRow(std::move(pRow)), pRowName);
+    }
+
+    /**
+     * @brief   Append rows after the last row. Storage is reserved once for all rows, and
+     *          labels are updated once after the rows are added.
+     * @param   pRows                 vector of rows, each a vector of row data.
+     * @param   pRowNames             row label names (optional argument), one per row.
+     */
+    template<typename T>
+    void AppendRows(const std::vector<std::vector<T>>& pRows,
+                    const std::vector<std::string>& pRowNames = std::vector<std::string>())
+    {
+      Converter<T> converter(mConverterParams, mNumericLocale);
+      std::vector<std::vector<std::string>> rows(pRows.size());
+      for (size_t i = 0; i < pRows.size(); ++i)
+      {
+        rows[i].resize(pRows[i].size());
+        for (size_t j = 0; j < pRows[i].size(); ++j)
+        {
+          converter.ToStr(pRows[i][j], rows[i][j]);
+        }
+      }
+
+      AppendRows(std::move(rows), pRowNames);
+    }
+
+    /**
+     * @brief   Append rows after the last row, moving the strings into the Document.
+     * @param   pRows                 vector of rows, each a vector of row data.
+     * @param   pRowNames             row label names (optional argument), one per row.
+     */
+    void AppendRows(std::vector<std::vector<std::string>>&& pRows,
+                    const std::vector<std::string>& pRowNames = std::vector<std::string>())
+    {
+      if (!pRowNames.empty() && (pRowNames.size() != pRows.size()))
+      {
+        throw std::out_of_range("row name count " + std::to_string(pRowNames.size()) +
+                                " does not match row count " + std::to_string(pRows.size()));
+      }
+
+      if (!pRowNames.empty() && (mLabelParams.mRowNameIdx < 0))
+      {
+        throw std::out_of_range("row name column index < 0: " + std::to_string(mLabelParams.mRowNameIdx));
+      }
+
+      MakeMutable();
+      InvalidateColumnCache();
+      const size_t firstRowIdx = GetDataRowIndex(0);
+      if (firstRowIdx > GetDataRowCount())
+      {
+        mRowNames.Reset();
+      }
+
+      mData.reserve(std::max(firstRowIdx, mData.size()) + pRows.size());
+      while (firstRowIdx > GetDataRowCount())
+      {
+        mData.push_back(MakeEmptyRow(GetDataColumnCount()));
+      }
+
+      const size_t firstAppendedIdx = mData.size();
+      for (size_t i = 0; i < pRows.size(); ++i)
+      {
+        mData.push_back(MakeDataRow(std::move(pRows[i])));
+        if (!pRowNames.empty())
+        {
+          std::vector<std::string>& row = mData.back();
+          const size_t rowNameIdx = static_cast<size_t>(mLabelParams.mRowNameIdx);
+          if (row.size() <= rowNameIdx)
+          {
+            row.resize(rowNameIdx + 1);
+          }
+          row[rowNameIdx] = pRowNames[i];
+        }
+      }
+      pRows.clear();
+
+      // appended labels are last, so they take precedence over any earlier duplicates
+      detail::LabelIndex* rowNames = mRowNames.GetIfBuilt();
+      if (rowNames != nullptr)
+      {
+        const size_t rowNameIdx = static_cast<size_t>(mLabelParams.mRowNameIdx);
+        for (size_t dataRowIdx = firstAppendedIdx; dataRowIdx < mData.size(); ++dataRowIdx)
+        {
+          if (mData[dataRowIdx].size() > rowNameIdx)
+          {
+            rowNames->Set(mData[dataRowIdx][rowNameIdx], dataRowIdx);
+          }
+        }
+      }
+    }
+
+    /**
+     * @brief   Get number of data rows (excluding label rows).
+     * @returns row count.
+     */
+    size_t GetRowCount() const
+    {
+      const int count = static_cast<int>(GetDataRowCount()) - (mLabelParams.mColumnNameIdx + 1);
+      return (count >= 0) ? static_cast<size_t>(count) : 0;
+    }
+
+    /**
+     * @brief   Get cell by index.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pRowIdx               zero-based row index.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const size_t pColumnIdx, const size_t pRowIdx) const
+    {
+      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
+      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+
+      T val;
+      Converter<T> converter(mConverterParams, mNumericLocale);
+      std::string buffer;
+      converter.ToVal(GetDataCell(dataRowIdx, dataColumnIdx, buffer), val);
+      return val;
+    }
+
+    /**
+     * @brief   Get cell by index.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pToVal                conversion function.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const size_t pColumnIdx, const size_t pRowIdx, ConvFunc<T> pToVal) const
+    {
+      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
+      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+
+      T val;
+      std::string buffer;
+      pToVal(GetDataCell(dataRowIdx, dataColumnIdx, buffer), val);
+      return val;
+    }
+
+    /**
+     * @brief   Get cell by name.
+     * @param   pColumnName           column label name.
+     * @param   pRowName              row label name.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const std::string& pColumnName, const std::string& pRowName) const
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+
+      const int rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+
+      return GetCell<T>(static_cast<size_t>(columnIdx), static_cast<size_t>(rowIdx));
+    }
+
+    /**
+     * @brief   Get cell by name.
+     * @param   pColumnName           column label name.
+     * @param   pRowName              row label name.
+     * @param   pToVal                conversion function.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const std::string& pColumnName, const std::string& pRowName, ConvFunc<T> pToVal) const
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+
+      const int rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+
+      return GetCell<T>(static_cast<size_t>(columnIdx), static_cast<size_t>(rowIdx), pToVal);
+    }
+
+    /**
+     * @brief   Get cell by column name and row index.
+     * @param   pColumnName           column label name.
+     * @param   pRowIdx               zero-based row index.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const std::string& pColumnName, const size_t pRowIdx) const
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+
+      return GetCell<T>(static_cast<size_t>(columnIdx), pRowIdx);
+    }
+
+    /**
+     * @brief   Get cell by column name and row index.
+     * @param   pColumnName           column label name.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pToVal                conversion function.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const std::string& pColumnName, const size_t pRowIdx, ConvFunc<T> pToVal) const
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+
+      return GetCell<T>(static_cast<size_t>(columnIdx), pRowIdx, pToVal);
+    }
+
+    /**
+     * @brief   Get cell by column index and row name.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pRowName              row label name.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const size_t pColumnIdx, const std::string& pRowName) const
+    {
+      const int rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+
+      return GetCell<T>(pColumnIdx, static_cast<size_t>(rowIdx));
+    }
+
+    /**
+     * @brief   Get cell by column index and row name.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pRowName              row label name.
+     * @param   pToVal                conversion function.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const size_t pColumnIdx, const std::string& pRowName, ConvFunc<T> pToVal) const
+    {
+      const int rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+
+      return GetCell<T>(pColumnIdx, static_cast<size_t>(rowIdx), pToVal);
+    }
+
+    /**
+     * @brief   Get cell by column handle and row index.
+     * @param   pColumn               column handle.
+     * @param   pRowIdx               zero-based row index.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const ColumnHandle<T>& pColumn, const size_t pRowIdx) const
+    {
+      return ConvertDataCell(pColumn.mConverter, GetDataRowIndex(pRowIdx), pColumn.mDataColumnIdx);
+    }
+
+    /**
+     * @brief   Get cell by column handle and row handle.
+     * @param   pColumn               column handle.
+     * @param   pRow                  row handle.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const ColumnHandle<T>& pColumn, const RowHandle& pRow) const
+    {
+      return ConvertDataCell(pColumn.mConverter, pRow.mDataRowIdx, pColumn.mDataColumnIdx);
+    }
+
+    /**
+     * @brief   Get column handle by index, for repeated cell access.
+     * @param   pColumnIdx            zero-based column index.
+     * @returns column handle.
+     */
+    template<typename T>
+    ColumnHandle<T> GetColumnHandle(const size_t pColumnIdx) const
+    {
+      if (pColumnIdx >= GetColumnCount())
+      {
+        throw std::out_of_range("column out of range: " + std::to_string(pColumnIdx));
+      }
+
+      return ColumnHandle<T>(pColumnIdx, GetDataColumnIndex(pColumnIdx), mConverterParams,
+                             mNumericLocale);
+    }
+
+    /**
+     * @brief   Get column handle by name, for repeated cell access.
+     * @param   pColumnName           column label name.
+     * @returns column handle.
+     */
+    template<typename T>
+    ColumnHandle<T> GetColumnHandle(const std::string& pColumnName) const
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+
+      return GetColumnHandle<T>(static_cast<size_t>(columnIdx));
+    }
+
+    /**
+     * @brief   Get row handle by index, for repeated cell access.
+     * @param   pRowIdx               zero-based row index.
+     * @returns row handle.
+     */
+    RowHandle GetRowHandle(const size_t pRowIdx) const
+    {
+      if (pRowIdx >= GetRowCount())
+      {
+        throw std::out_of_range("row out of range: " + std::to_string(pRowIdx));
+      }
+
+      return RowHandle(pRowIdx, GetDataRowIndex(pRowIdx));
+    }
+
+    /**
+     * @brief   Get row handle by name, for repeated cell access.
+     * @param   pRowName              row label name.
+     * @returns row handle.
+     */
+    RowHandle GetRowHandle(const std::string& pRowName) const
+    {
+      const int rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+
+      return GetRowHandle(static_cast<size_t>(rowIdx));
+    }
+
+    /**
+     * @brief   Set cell by index.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pCell                 cell data.
+     */
+    template<typename T>
+    void SetCell(const size_t pColumnIdx, const size_t pRowIdx, const T& pCell)
+    {
+      MakeMutable();
+      InvalidateColumnCache(pColumnIdx, false);
+      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
+      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+      SetModified(((dataColumnIdx + 1) > GetDataColumnCount()) ? 0 : dataRowIdx);
+
+      while ((dataRowIdx + 1) > GetDataRowCount())
+      {
+        InvalidateColumnCache();
+        mData.push_back(MakeEmptyRow(GetDataColumnCount()));
+      }
+
+      if ((dataColumnIdx + 1) > GetDataColumnCount())
+      {
+        for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
+        {
+          if (std::distance(mData.begin(), itRow) >= mLabelParams.mColumnNameIdx)
+          {
+            itRow->resize(dataColumnIdx + 1);
+          }
+        }
+      }
+
+      std::string str;
+      Converter<T> converter(mConverterParams, mNumericLocale);
+      converter.ToStr(pCell, str);
+      mData.at(dataRowIdx).at(dataColumnIdx) = str;
+    }
+
+    /**
+     * @brief   Set cell by name.
+     * @param   pColumnName           column label name.
+     * @param   pRowName              row label name.
+     * @param   pCell                 cell data.
+     */
+    template<typename T>
+    void SetCell(const std::string& pColumnName, const std::string& pRowName, const T& pCell)
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+
+      const int rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+
+      SetCell<T>(static_cast<size_t>(columnIdx), static_cast<size_t>(rowIdx), pCell);
+    }
+
+    /**
+     * @brief   Set cell by column index and row name.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pRowName              row label name.
+     * @param   pCell                 cell data.
+     */
+    template<typename T>
+    void SetCell(const size_t pColumnIdx, const std::string& pRowName, const T& pCell)
+    {
+      const int rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+
+      SetCell<T>(pColumnIdx, static_cast<size_t>(rowIdx), pCell);
+    }
+
+    /**
+     * @brief   Set cell by column name and row index.
+     * @param   pColumnName           column label name.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pCell                 cell data.
+     */
+    template<typename T>
+    void SetCell(const std::string& pColumnName, const size_t pRowIdx, const T& pCell)
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+
+      SetCell<T>(static_cast<size_t>(columnIdx), pRowIdx, pCell);
+    }
+
+    /**
+     * @brief   Get column name
+     * @param   pColumnIdx            zero-based column index.
+     * @returns column name.
+     */
+    std::string GetColumnName(const size_t pColumnIdx) const
+    {
+      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
+      if (mLabelParams.mColumnNameIdx < 0)
+      {
+        throw std::out_of_range("column name row index < 0: " + std::to_string(mLabelParams.mColumnNameIdx));
+      }
+
+      std::string buffer;
+      return GetDataCell(static_cast<size_t>(mLabelParams.mColumnNameIdx), dataColumnIdx, buffer);
+    }
+
+    /**
+     * @brief   Set column name
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pColumnName           column name.
+     */
+    void SetColumnName(size_t pColumnIdx, const std::string& pColumnName)
+    {
+      MakeMutable();
+      if (mLabelParams.mColumnNameIdx < 0)
+      {
+        throw std::out_of_range("column name row index < 0: " + std::to_string(mLabelParams.mColumnNameIdx));
+      }
+
+      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
+      mColumnNames.Set(pColumnName, dataColumnIdx);
+      SetModified(0);
+
+      // increase table size if necessary:
+      const size_t rowIdx = static_cast<size_t>(mLabelParams.mColumnNameIdx);
+      if (rowIdx >= mData.size())
+      {
+        mData.resize(rowIdx + 1);
+      }
+      auto& row = mData[rowIdx];
+      if (dataColumnIdx >= row.size())
+      {
+        row.resize(dataColumnIdx + 1);
+      }
+
+      mData.at(static_cast<size_t>(mLabelParams.mColumnNameIdx)).at(dataColumnIdx) = pColumnName;
+    }
+
+    /**
+     * @brief   Get column names
+     * @returns vector of column names.
      */
-    void Load(const std::string& pPath,
-              const LabelParams& pLabelParams = LabelParams(),
-              const SeparatorParams& pSeparatorParams = SeparatorParams(),
-              const ConverterParams& pConverterParams = ConverterParams(),
-              const LineReaderParams& pLineReaderParams = LineReaderParams())
+    std::vector<std::string> GetColumnNames() const
+    {
+      if (mLabelParams.mColumnNameIdx >= 0)
+      {
+        const size_t dataRowIdx = static_cast<size_t>(mLabelParams.mColumnNameIdx);
+        const size_t rowSize = GetDataRowSize(dataRowIdx);
+        std::vector<std::string> columnNames;
+        std::string buffer;
+        for (size_t dataColumnIdx = GetDataColumnIndex(0); dataColumnIdx < rowSize; ++dataColumnIdx)
+        {
+          columnNames.push_back(GetDataCell(dataRowIdx, dataColumnIdx, buffer));
+        }
+        return columnNames;
+      }
+
+      return std::vector<std::string>();
+    }
+
+    /**
+     * @brief   Get row name
+     * @param   pRowIdx               zero-based column index.
+     * @returns row name.
+     */
+    std::string GetRowName(const size_t pRowIdx) const
+    {
+      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+      if (mLabelParams.mRowNameIdx < 0)
+      {
+        throw std::out_of_range("row name column index < 0: " + std::to_string(mLabelParams.mRowNameIdx));
+      }
+
+      std::string buffer;
+      return GetDataCell(dataRowIdx, static_cast<size_t>(mLabelParams.mRowNameIdx), buffer);
+    }
+
+    /**
+     * @brief   Set row name
+     * @param   pRowIdx               zero-based row index.
+     * @param   pRowName              row name.
+     */
+    void SetRowName(size_t pRowIdx, const std::string& pRowName)
+    {
+      MakeMutable();
+      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+      if (mLabelParams.mRowNameIdx < 0)
+      {
+        throw std::out_of_range("row name column index < 0: " + std::to_string(mLabelParams.mRowNameIdx));
+      }
+
+      SetModified(dataRowIdx);
+
+      // increase table size if necessary:
+      if (dataRowIdx >= mData.size())
+      {
+        InvalidateColumnCache();
+        mData.resize(dataRowIdx + 1);
+      }
+      auto& row = mData[dataRowIdx];
+      const size_t rowNameIdx = static_cast<size_t>(mLabelParams.mRowNameIdx);
+      const bool hasRowName = (row.size() > rowNameIdx);
+      if (!hasRowName)
+      {
+        row.resize(rowNameIdx + 1);
+      }
+
+      detail::LabelIndex* rowNames = mRowNames.GetIfBuilt();
+      if (rowNames != nullptr)
+      {
+        // update the built index in place, unless the new label is already used by another row
+        size_t rowIdx = 0;
+        if (rowNames->HasDuplicates() || (rowNames->Find(pRowName, rowIdx) && (rowIdx != dataRowIdx)))
+        {
+          mRowNames.Reset();
+        }
+        else
+        {
+          if (hasRowName)
+          {
+            rowNames->Erase(row[rowNameIdx]);
+          }
+          rowNames->Set(pRowName, dataRowIdx);
+        }
+      }
+
+      row[rowNameIdx] = pRowName;
+    }
+
+    /**
+     * @brief   Get row names
+     * @returns vector of row names.
+     */
+    std::vector<std::string> GetRowNames() const
+    {
+      std::vector<std::string> rownames;
+      if (mLabelParams.mRowNameIdx >= 0)
+      {
+        std::string buffer;
+        const size_t rowCount = GetDataRowCount();
+        for (size_t dataRowIdx = GetDataRowIndex(0); dataRowIdx < rowCount; ++dataRowIdx)
+        {
+          rownames.push_back(GetDataCell(dataRowIdx, static_cast<size_t>(mLabelParams.mRowNameIdx), buffer));
+        }
+      }
+      return rownames;
+    }
+
+  private:
+    void ReadCsv()
+    {
+#ifdef RAPIDCSV_HAS_MMAP
+      if (mLoadParams.mMemoryMap)
+      {
+        detail::MappedFile mappedFile;
+        if (mappedFile.Open(mPath))
+        {
+          ReadCsv(mappedFile.GetData(), mappedFile.GetSize());
+          SetLoaded();
+          return;
+        }
+      }
+#endif
+
+      std::ifstream stream;
+      stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+      stream.open(mPath, std::ios::binary);
+      ReadCsv(stream);
+      SetLoaded();
+    }
+
+    void SetLoaded()
+    {
+      // with selected columns or filtered rows the Document does not hold all rows and columns
+      // of the file, so appending would corrupt it
+      if (!mLoadParams.mRowFilter && mLoadParams.mSelectedColumnIdxs.empty() &&
+          mLoadParams.mSelectedColumnNames.empty())
+      {
+        SetSaved();
+      }
+      else
+      {
+        mSavedPath.clear();
+      }
+    }
+
+    void SetSaved()
+    {
+      // rows up to here are stored in the file, later rows can be appended to it
+      mSavedPath = mPath;
+      mSavedRowCount = GetDataRowCount();
+
+      // the file stamp detects changes to the file by others before appending
+      if (!detail::GetFileStamp(mPath, mSavedSize, mSavedTime))
+      {
+        mSavedSize = -1;
+      }
+    }
+
+    void SetModified(const size_t pDataRowIdx)
+    {
+      if (pDataRowIdx < mSavedRowCount)
+      {
+        mSavedPath.clear();
+      }
+    }
+
+    void ReadCsv(std::istream& pStream)
+    {
+      Clear();
+      std::streamsize length = GetStreamLength(pStream);
+
+      // streams of unknown length, such as pipes, are read completely before parsing
+      if (length < 0)
+      {
+        const std::vector<char> buffer((std::istreambuf_iterator<char>(pStream)),
+                                       std::istreambuf_iterator<char>());
+        ReadCsv(buffer.data(), buffer.size());
+        return;
+      }
+
+      // parallel parsing requires all data in memory
+      if (GetLoadThreadCount() > 1)
+      {
+        std::vector<char> buffer(static_cast<size_t>(length));
+        pStream.read(buffer.data(), length);
+        ReadCsv(buffer.data(), static_cast<size_t>(pStream.gcount()));
+        return;
+      }
+
+#ifdef HAS_CODECVT
+      std::vector<char> bom2b(2, '\0');
+      if (length >= 2)
+      {
+        pStream.read(bom2b.data(), 2);
+        pStream.seekg(0, std::ios::beg);
+      }
+
+      if (IsUtf16BOM(bom2b.data(), bom2b.size()))
+      {
+        std::vector<char> buffer(static_cast<size_t>(length));
+        pStream.read(buffer.data(), length);
+        ParseUtf16(buffer.data(), buffer.size());
+      }
+      else
+#endif
+      {
+        // check for UTF-8 Byte order mark and skip it when found
+        if (length >= 3)
+        {
+          std::vector<char> bom3b(3, '\0');
+          pStream.read(bom3b.data(), 3);
+
+          if (bom3b != s_Utf8BOM)
+          {
+            // file does not start with a UTF-8 Byte order mark
+            pStream.seekg(0, std::ios::beg);
+          }
+          else
+          {
+            // file did start with a UTF-8 Byte order mark, simply skip it
+            length -= 3;
+            mHasUtf8BOM = true;
+          }
+        }
+
+        ParseCsv(pStream, length);
+      }
+    }
+
+    static std::streamsize GetStreamLength(std::istream& pStream)
+    {
+      // seeking fails on non-seekable streams, which must not throw here
+      const std::ios_base::iostate exceptions = pStream.exceptions();
+      pStream.exceptions(std::ios_base::goodbit);
+      pStream.seekg(0, std::ios::end);
+      const std::streamsize length = pStream.tellg();
+      if (length >= 0)
+      {
+        pStream.seekg(0, std::ios::beg);
+      }
+      else
+      {
+        pStream.clear();
+      }
+
+      pStream.exceptions(exceptions);
+      return length;
+    }
+
+    void ReadCsv(const char* pData, size_t pLength)
+    {
+      Clear();
+
+#ifdef HAS_CODECVT
+      if (IsUtf16BOM(pData, pLength))
+      {
+        ParseUtf16(pData, pLength);
+      }
+      else
+#endif
+      {
+        // check for UTF-8 Byte order mark and skip it when found
+        if ((pLength >= 3) && std::equal(s_Utf8BOM.begin(), s_Utf8BOM.end(), pData))
+        {
+          pData += 3;
+          pLength -= 3;
+          mHasUtf8BOM = true;
+        }
+
+        ParseCsv(pData, pLength);
+      }
+    }
+
+#ifdef HAS_CODECVT
+    static bool IsUtf16BOM(const char* pData, const size_t pLength)
+    {
+      return (pLength >= 2) &&
+             (((pData[0] == '\xff') && (pData[1] == '\xfe')) || ((pData[0] == '\xfe') && (pData[1] == '\xff')));
+    }
+
+    void ParseUtf16(const char* pData, const size_t pLength)
+    {
+      mIsUtf16 = true;
+      mIsLE = (pData[0] == '\xff');
+
+      const std::wstring& utf16 = [&]()
+      {
+        if (mIsLE)
+        {
+          const std::codecvt_mode mode =
+            static_cast<std::codecvt_mode>(std::consume_header | std::little_endian);
+          std::wstring_convert<std::codecvt_utf16<wchar_t, 0x10ffff, mode>> utf16conv;
+          return utf16conv.from_bytes(pData, pData + pLength);
+        }
+        else
+        {
+          const std::codecvt_mode mode =
+            static_cast<std::codecvt_mode>(std::consume_header);
+          std::wstring_convert<std::codecvt_utf16<wchar_t, 0x10ffff, mode>> utf16conv;
+          return utf16conv.from_bytes(pData, pData + pLength);
+        }
+      }();
+
+      std::wstringstream wss(utf16);
+      std::string utf8 = ToString(wss.str());
+      ParseCsv(utf8.data(), utf8.size());
+    }
+#endif
+
+    void ParseCsv(std::istream& pStream, const std::streamsize p_FileLength)
+    {
+      if (mLoadParams.mArenaStorage)
+      {
+        ParseCsv(pStream, p_FileLength, mArena);
+      }
+      else
+      {
+        detail::RowTable table;
+        ParseCsv(pStream, p_FileLength, table);
+        mData.swap(table.GetRows());
+      }
+
+      ParseDone();
+    }
+
+    void ParseCsv(const char* pData, const size_t pLength)
+    {
+      if (mLoadParams.mArenaStorage)
+      {
+        ParseCsv(pData, pLength, mArena);
+      }
+      else
+      {
+        detail::RowTable table;
+        ParseCsv(pData, pLength, table);
+        mData.swap(table.GetRows());
+      }
+
+      ParseDone();
+    }
+
+    template<typename TTable>
+    void ParseCsv(std::istream& pStream, std::streamsize p_FileLength, TTable& pTable)
+    {
+      const std::streamsize bufLength = 64 * 1024;
+      std::vector<char> buffer(bufLength);
+      detail::Tokenizer tokenizer(mSeparatorParams, mLineReaderParams);
+      detail::ColumnSelection selection(mLabelParams, mLoadParams);
+      detail::LoadHandler<TTable> handler(selection, mLoadParams.mRowFilter, pTable);
+      bool first = true;
+
+      while (p_FileLength > 0)
+      {
+        const std::streamsize toReadLength = std::min<std::streamsize>(p_FileLength, bufLength);
+        pStream.read(buffer.data(), toReadLength);
+
+        // With user-specified istream opened in non-binary mode on windows, we may have a
+        // data length mismatch, so ensure we don't parse outside actual data length read.
+        const std::streamsize readLength = pStream.gcount();
+        if (readLength <= 0)
+        {
+          break;
+        }
+
+        if (first)
+        {
+          first = false;
+          ReserveTable(buffer.data(), static_cast<size_t>(readLength), static_cast<size_t>(p_FileLength), pTable);
+        }
+
+        tokenizer.Parse(buffer.data(), static_cast<size_t>(readLength), handler);
+        p_FileLength -= readLength;
+      }
+
+      // Handle last row / cell without linebreak
+      tokenizer.Finish(handler);
+      handler.Finish();
+
+      SetLinebreakStyle(tokenizer.GetCRCount(), tokenizer.GetLFCount());
+    }
+
+    template<typename TTable>
+    void ParseCsv(const char* pData, const size_t pLength, TTable& pTable)
     {
-      mPath = pPath;
-      mLabelParams = pLabelParams;
-      mSeparatorParams = pSeparatorParams;
-      mConverterParams = pConverterParams;
-      mLineReaderParams = pLineReaderParams;
-      ReadCsv();
+      detail::Tokenizer tokenizer(mSeparatorParams, mLineReaderParams);
+      detail::ColumnSelection selection(mLabelParams, mLoadParams);
+      detail::LoadHandler<TTable> handler(selection, mLoadParams.mRowFilter, pTable);
+
+      // Parse label rows before any parallel parsing, to resolve selected column names, check
+      // selected column indices against the column count and ensure all chunks only contain
+      // data rows
+      size_t offset = 0;
+      while ((!selection.IsResolved() || !selection.IsColumnCountChecked() || handler.IsLabelRow()) &&
+             (offset < pLength))
+      {
+        offset += tokenizer.Parse(pData + offset, pLength - offset, handler, true /* pStopAtRowEnd */);
+      }
+
+      const size_t minChunkLength = 256 * 1024;
+      const size_t chunkCount = std::min(GetLoadThreadCount(), (pLength - offset) / minChunkLength);
+      if (chunkCount > 1)
+      {
+        ParseCsvParallel(pData + offset, pLength - offset, chunkCount, selection, pTable,
+                         tokenizer.GetCRCount(), tokenizer.GetLFCount());
+        return;
+      }
+
+      const size_t sampleLength = std::min<size_t>(pLength - offset, 64 * 1024);
+      ReserveTable(pData + offset, sampleLength, pLength - offset, pTable);
+      tokenizer.Parse(pData + offset, pLength - offset, handler);
+
+      // Handle last row / cell without linebreak
+      tokenizer.Finish(handler);
+      handler.Finish();
+
+      SetLinebreakStyle(tokenizer.GetCRCount(), tokenizer.GetLFCount());
     }
 
-    /**
-     * @brief   Read Document data from stream.
-     * @param   pStream               specifies a binary input stream to read CSV data from.
-     * @param   pLabelParams          specifies which row and column should be treated as labels.
-     * @param   pSeparatorParams      specifies which field and row separators should be used.
-     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
-     *                                handled.
-     * @param   pLineReaderParams     specifies how special line formats should be treated.
-     */
-    void Load(std::istream& pStream,
-              const LabelParams& pLabelParams = LabelParams(),
-              const SeparatorParams& pSeparatorParams = SeparatorParams(),
-              const ConverterParams& pConverterParams = ConverterParams(),
-              const LineReaderParams& pLineReaderParams = LineReaderParams())
+    template<typename TTable>
+    void ParseCsvParallel(const char* pData, const size_t pLength, const size_t pChunkCount,
+                          detail::ColumnSelection& pSelection, TTable& pTable, int pCR, int pLF)
     {
-      mPath = "";
-      mLabelParams = pLabelParams;
-      mSeparatorParams = pSeparatorParams;
-      mConverterParams = pConverterParams;
-      mLineReaderParams = pLineReaderParams;
-      ReadCsv(pStream);
+      const std::vector<size_t> offsets = detail::SplitChunks(pData, pLength, pChunkCount, mSeparatorParams);
+      const size_t chunkCount = offsets.size() - 1;
+
+      std::vector<TTable> tables(chunkCount);
+      std::vector<detail::Tokenizer> tokenizers(chunkCount, detail::Tokenizer(mSeparatorParams, mLineReaderParams));
+      std::vector<detail::LoadHandler<TTable>> handlers;
+      handlers.reserve(chunkCount);
+      for (auto& table : tables)
+      {
+        handlers.emplace_back(pSelection, mLoadParams.mRowFilter, table, pSelection.GetLabelRowCount());
+      }
+
+      detail::ParallelFor(chunkCount, chunkCount, [&](size_t pIdx)
+      {
+        tokenizers[pIdx].Parse(pData + offsets[pIdx], offsets[pIdx + 1] - offsets[pIdx], handlers[pIdx]);
+      });
+
+      // Stitch chunks in order. A chunk not ending at a row boundary means that the following
+      // split points were mispredicted, in which case the remaining data is parsed sequentially.
+      size_t lastChunk = chunkCount - 1;
+      for (size_t i = 0; i <= lastChunk; ++i)
+      {
+        if ((i < lastChunk) && !tokenizers[i].IsAtRowStart())
+        {
+          tokenizers[i].Parse(pData + offsets[i + 1], pLength - offsets[i + 1], handlers[i]);
+          lastChunk = i;
+        }
+
+        if (i == lastChunk)
+        {
+          // Handle last row / cell without linebreak
+          tokenizers[i].Finish(handlers[i]);
+          handlers[i].Finish();
+        }
+
+        pTable.Append(tables[i]);
+        pCR += tokenizers[i].GetCRCount();
+        pLF += tokenizers[i].GetLFCount();
+      }
+
+      SetLinebreakStyle(pCR, pLF);
     }
 
-    /**
-     * @brief   Write Document data to file.
-     * @param   pPath                 optionally specifies the path where the CSV-file will be created
-     *                                (if not specified, the original path provided when creating or
-     *                                loading the Document data will be used).
-     */
-    void Save(const std::string& pPath = std::string())
+    template<typename TTable>
+    void ReserveTable(const char* pSample, const size_t pSampleLength, const size_t pLength, TTable& pTable) const
     {
-      if (!pPath.empty())
+      // filtered rows and columns would make the estimate too large
+      if (!mLoadParams.mRowFilter && mLoadParams.mSelectedColumnIdxs.empty() &&
+          mLoadParams.mSelectedColumnNames.empty())
       {
-        mPath = pPath;
+        pTable.Reserve(detail::EstimateTableSize(pSample, pSampleLength, pLength, mSeparatorParams.mSeparator));
       }
-      WriteCsv();
     }
 
-    /**
-     * @brief   Write Document data to stream.
-     * @param   pStream               specifies a binary output stream to write the data to.
-     */
-    void Save(std::ostream& pStream) const
+    void SetLinebreakStyle(const int pCR, const int pLF)
     {
-      WriteCsv(pStream);
+      // Assume CR/LF if at least half the linebreaks have CR
+      mSeparatorParams.mHasCR = (pCR > (pLF / 2));
     }
 
-    /**
-     * @brief   Clears loaded Document data.
-     *
-     */
-    void Clear()
+    void ParseDone()
     {
-      mData.clear();
-      mColumnNames.clear();
-      mRowNames.clear();
-#ifdef HAS_CODECVT
-      mIsUtf16 = false;
-      mIsLE = false;
-#endif
-      mHasUtf8BOM = false;
+      // Set up column labels
+      UpdateColumnNames();
+
+      // Row labels are indexed on first lookup
+      mRowNames.Reset();
     }
 
-    /**
-     * @brief   Get column index by name.
-     * @param   pColumnName           column label name.
-     * @returns zero-based column index.
-     */
-    int GetColumnIdx(const std::string& pColumnName) const
+    bool AppendCsv() const
     {
-      if (mLabelParams.mColumnNameIdx >= 0)
+#ifdef HAS_CODECVT
+      if (mIsUtf16)
+      {
+        return false;
+      }
+#endif
+
+      if (mSavedPath.empty() || (mSavedPath != mPath))
+      {
+        return false;
+      }
+
+      // a file changed since it was loaded or saved may no longer hold the saved rows
+      int64_t stampSize = 0;
+      int64_t stampTime = 0;
+      if (detail::GetFileStamp(mPath, stampSize, stampTime) &&
+          ((stampSize != mSavedSize) || (stampTime != mSavedTime)))
+      {
+        return false;
+      }
+
+      // a missing line end after the last row in the file is added before appending
+      std::ifstream file(mPath, std::ios::binary | std::ios::ate);
+      if (!file.is_open())
+      {
+        return false;
+      }
+
+      const std::streamoff size = file.tellg();
+      char lastChar = '\n';
+      if (size > 0)
+      {
+        file.seekg(-1, std::ios::end);
+        file.get(lastChar);
+      }
+      file.close();
+
+      const detail::CellFormatter formatter(mSeparatorParams);
+      std::string out;
+      if (size <= 0)
       {
-        if (mColumnNames.find(pColumnName) != mColumnNames.end())
+        if (mHasUtf8BOM)
         {
-          return static_cast<int>(mColumnNames.at(pColumnName)) - (mLabelParams.mRowNameIdx + 1);
+          out.append(s_Utf8BOM.data(), 3);
         }
       }
-      return -1;
-    }
+      else if (lastChar != '\n')
+      {
+        formatter.AppendLineEnd(out);
+      }
 
-    /**
-     * @brief   Get column by index.
-     * @param   pColumnIdx            zero-based column index.
-     * @returns vector of column data.
-     */
-    template<typename T>
-    std::vector<T> GetColumn(const size_t pColumnIdx) const
-    {
-      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
-      std::vector<T> column;
-      Converter<T> converter(mConverterParams);
-      for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
+      std::ofstream stream;
+      stream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+      stream.open(mPath, std::ios::binary | std::ios::app);
+      const size_t rowCount = GetDataRowCount();
+      for (size_t dataRowIdx = mSavedRowCount; dataRowIdx < rowCount; ++dataRowIdx)
       {
-        if (std::distance(mData.begin(), itRow) > mLabelParams.mColumnNameIdx)
+        FormatRow(dataRowIdx, formatter, out);
+        if (out.size() >= sWriteBufferSize)
         {
-          if (dataColumnIdx < itRow->size())
-          {
-            T val;
-            converter.ToVal(itRow->at(dataColumnIdx), val);
-            column.push_back(val);
-          }
-          else
-          {
-            const std::string errStr = "requested column index " +
-              std::to_string(pColumnIdx) + " >= " +
-              std::to_string(itRow->size() - GetDataColumnIndex(0)) +
-              " (number of columns on row index " +
-              std::to_string(std::distance(mData.begin(), itRow) -
-                             (mLabelParams.mColumnNameIdx + 1)) + ")";
-            throw std::out_of_range(errStr);
-          }
+          stream.write(out.data(), static_cast<std::streamsize>(out.size()));
+          out.clear();
         }
       }
-      return column;
+
+      stream.write(out.data(), static_cast<std::streamsize>(out.size()));
+      stream.close();
+      return true;
     }
 
-    /**
-     * @brief   Get column by index.
-     * @param   pColumnIdx            zero-based column index.
-     * @param   pToVal                conversion function.
-     * @returns vector of column data.
-     */
-    template<typename T>
-    std::vector<T> GetColumn(const size_t pColumnIdx, ConvFunc<T> pToVal) const
+    void WriteCsv(const SaveParams& pSaveParams) const
     {
-      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
-      std::vector<T> column;
-      for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
+      if (!pSaveParams.mAtomic)
+      {
+        WriteCsv(mPath, pSaveParams);
+        return;
+      }
+
+      const std::string tempPath = detail::GetTempPath(mPath);
+      try
       {
-        if (std::distance(mData.begin(), itRow) > mLabelParams.mColumnNameIdx)
+        WriteCsv(tempPath, pSaveParams);
+        if (pSaveParams.mSync)
         {
-          T val;
-          pToVal(itRow->at(dataColumnIdx), val);
-          column.push_back(val);
+          detail::SyncPath(tempPath);
         }
+
+        detail::ReplaceFile(tempPath, mPath);
+      }
+      catch (...)
+      {
+        std::remove(tempPath.c_str());
+        throw;
       }
-      return column;
-    }
 
-    /**
-     * @brief   Get column by name.
-     * @param   pColumnName           column label name.
-     * @returns vector of column data.
-     */
-    template<typename T>
-    std::vector<T> GetColumn(const std::string& pColumnName) const
-    {
-      const int columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
+      if (pSaveParams.mSync)
       {
-        throw std::out_of_range("column not found: " + pColumnName);
+        detail::SyncPath(detail::GetDirPath(mPath));
       }
-      return GetColumn<T>(static_cast<size_t>(columnIdx));
     }
 
-    /**
-     * @brief   Get column by name.
-     * @param   pColumnName           column label name.
-     * @param   pToVal                conversion function.
-     * @returns vector of column data.
-     */
-    template<typename T>
-    std::vector<T> GetColumn(const std::string& pColumnName, ConvFunc<T> pToVal) const
+    void WriteCsv(const std::string& pPath, const SaveParams& pSaveParams) const
     {
-      const int columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
+#ifdef HAS_CODECVT
+      if (mIsUtf16)
       {
-        throw std::out_of_range("column not found: " + pColumnName);
+        std::stringstream ss;
+        WriteCsv(ss, pSaveParams);
+        std::string utf8 = ss.str();
+        std::wstring wstr = ToWString(utf8);
+
+        std::wofstream wstream;
+        wstream.exceptions(std::wofstream::failbit | std::wofstream::badbit);
+        wstream.open(pPath, std::ios::binary | std::ios::trunc);
+
+        if (mIsLE)
+        {
+          wstream.imbue(std::locale(wstream.getloc(),
+                                    new std::codecvt_utf16<wchar_t, 0x10ffff,
+                                                           static_cast<std::codecvt_mode>(std::little_endian)>));
+        }
+        else
+        {
+          wstream.imbue(std::locale(wstream.getloc(),
+                                    new std::codecvt_utf16<wchar_t, 0x10ffff>));
+        }
+
+        wstream << static_cast<wchar_t>(0xfeff);
+        wstream << wstr;
       }
-      return GetColumn<T>(static_cast<size_t>(columnIdx), pToVal);
-    }
+      else
+#endif
+#ifdef RAPIDCSV_HAS_MMAP
+      if (GetSaveThreadCount(pSaveParams) > 1)
+      {
+        // formatted chunks are written at their file offsets concurrently
+        detail::OutputFile file;
+        file.Create(pPath);
+        size_t offset = 0;
+        if (mHasUtf8BOM)
+        {
+          file.WriteAt(s_Utf8BOM.data(), 3, offset);
+          offset += 3;
+        }
 
-    /**
-     * @brief   Set column by index.
-     * @param   pColumnIdx            zero-based column index.
-     * @param   pColumn               vector of column data.
-     */
-    template<typename T>
-    void SetColumn(const size_t pColumnIdx, const std::vector<T>& pColumn)
-    {
-      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
+        const size_t threadCount = GetSaveThreadCount(pSaveParams);
+        WriteRowsParallel(threadCount, [&](const std::vector<std::string>& pChunks, const size_t pChunkCount)
+        {
+          std::vector<size_t> offsets(pChunkCount);
+          for (size_t i = 0; i < pChunkCount; ++i)
+          {
+            offsets[i] = offset;
+            offset += pChunks[i].size();
+          }
 
-      while (GetDataRowIndex(pColumn.size()) > GetDataRowCount())
+          detail::ParallelFor(pChunkCount, threadCount, [&](const size_t pChunkIdx)
+          {
+            file.WriteAt(pChunks[pChunkIdx].data(), pChunks[pChunkIdx].size(), offsets[pChunkIdx]);
+          });
+        });
+        file.Close();
+      }
+      else
+#endif
       {
-        std::vector<std::string> row;
-        row.resize(GetDataColumnCount());
-        mData.push_back(row);
+        std::ofstream stream;
+        stream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+        stream.open(pPath, std::ios::binary | std::ios::trunc);
+        if (mHasUtf8BOM)
+        {
+          stream.write(s_Utf8BOM.data(), 3);
+        }
+
+        WriteCsv(stream, pSaveParams);
+        stream.close();
       }
+    }
 
-      if ((dataColumnIdx + 1) > GetDataColumnCount())
+    void WriteCsv(std::ostream& pStream, const SaveParams& pSaveParams) const
+    {
+      const size_t threadCount = GetSaveThreadCount(pSaveParams);
+      if (threadCount > 1)
       {
-        for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
+        WriteRowsParallel(threadCount, [&](const std::vector<std::string>& pChunks, const size_t pChunkCount)
         {
-          if (std::distance(mData.begin(), itRow) >= mLabelParams.mColumnNameIdx)
+          for (size_t i = 0; i < pChunkCount; ++i)
           {
-            itRow->resize(GetDataColumnIndex(dataColumnIdx + 1));
+            pStream.write(pChunks[i].data(), static_cast<std::streamsize>(pChunks[i].size()));
           }
-        }
+        });
+        return;
       }
 
-      Converter<T> converter(mConverterParams);
-      for (auto itRow = pColumn.begin(); itRow != pColumn.end(); ++itRow)
+      // format into a reused buffer, written to the stream in large blocks
+      const detail::CellFormatter formatter(mSeparatorParams);
+      std::string out;
+      out.reserve(sWriteBufferSize + (sWriteBufferSize / 4));
+      const size_t rowCount = GetDataRowCount();
+      for (size_t dataRowIdx = 0; dataRowIdx < rowCount; ++dataRowIdx)
       {
-        std::string str;
-        converter.ToStr(*itRow, str);
-        mData.at(static_cast<size_t>(std::distance(pColumn.begin(), itRow) + mLabelParams.mColumnNameIdx + 1)).at(
-          dataColumnIdx) = str;
+        FormatRow(dataRowIdx, formatter, out);
+        if (out.size() >= sWriteBufferSize)
+        {
+          pStream.write(out.data(), static_cast<std::streamsize>(out.size()));
+          out.clear();
+        }
       }
-    }
 
-    /**
-     * @brief   Set column by name.
-     * @param   pColumnName           column label name.
-     * @param   pColumn               vector of column data.
-     */
-    template<typename T>
-    void SetColumn(const std::string& pColumnName, const std::vector<T>& pColumn)
+      pStream.write(out.data(), static_cast<std::streamsize>(out.size()));
+    }
+
+    void FormatRow(const size_t pDataRowIdx, const detail::CellFormatter& pFormatter, std::string& pOut) const
     {
-      const int columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
+      const size_t rowSize = GetDataRowSize(pDataRowIdx);
+      for (size_t dataColumnIdx = 0; dataColumnIdx < rowSize; ++dataColumnIdx)
       {
-        throw std::out_of_range("column not found: " + pColumnName);
+        size_t length = 0;
+        const char* cell = GetDataCell(pDataRowIdx, dataColumnIdx, length);
+        pFormatter.AppendCell(cell, length, pOut);
+
+        if ((dataColumnIdx + 1) < rowSize)
+        {
+          pFormatter.AppendSeparator(pOut);
+        }
       }
-      SetColumn<T>(static_cast<size_t>(columnIdx), pColumn);
+      pFormatter.AppendLineEnd(pOut);
     }
 
     /**
-     * @brief   Remove column by index.
-     * @param   pColumnIdx            zero-based column index.
+     * @brief   Formats consecutive chunks of rows concurrently, a batch of chunks at a time, and
+     *          passes each batch to pWrite in order. Memory use is bounded by the batch size.
      */
-    void RemoveColumn(const size_t pColumnIdx)
+    void WriteRowsParallel(const size_t pThreads,
+                           const std::function<void(const std::vector<std::string>&, size_t)>& pWrite) const
     {
-      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
-      for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
+      const detail::CellFormatter formatter(mSeparatorParams);
+      const size_t rowCount = GetDataRowCount();
+      std::vector<std::string> chunks(pThreads * 2);
+      for (size_t batchRowIdx = 0; batchRowIdx < rowCount; batchRowIdx += chunks.size() * sSaveChunkRows)
       {
-        if (std::distance(mData.begin(), itRow) >= mLabelParams.mColumnNameIdx)
+        const size_t batchRows = std::min(rowCount - batchRowIdx, chunks.size() * sSaveChunkRows);
+        const size_t chunkCount = (batchRows + sSaveChunkRows - 1) / sSaveChunkRows;
+        detail::ParallelFor(chunkCount, pThreads, [&](const size_t pChunkIdx)
         {
-          if (dataColumnIdx < itRow->size())
-          {
-            itRow->erase(itRow->begin() + static_cast<int>(dataColumnIdx));
-          }
-          else
+          std::string& chunk = chunks[pChunkIdx];
+          chunk.clear();
+          const size_t beginRowIdx = batchRowIdx + (pChunkIdx * sSaveChunkRows);
+          const size_t endRowIdx = std::min(beginRowIdx + sSaveChunkRows, batchRowIdx + batchRows);
+          for (size_t dataRowIdx = beginRowIdx; dataRowIdx < endRowIdx; ++dataRowIdx)
           {
-            const std::string errStr = "column out of range: " +
-              std::to_string(pColumnIdx) + " (on row " +
-              std::to_string(std::distance(mData.begin(), itRow)) +
-              ")";
-            throw std::out_of_range(errStr);
+            FormatRow(dataRowIdx, formatter, chunk);
           }
-        }
+        });
+
+        pWrite(chunks, chunkCount);
       }
+    }
 
-      UpdateColumnNames();
+    size_t GetSaveThreadCount(const SaveParams& pSaveParams) const
+    {
+      if (pSaveParams.mThreads != 0)
+      {
+        return pSaveParams.mThreads;
+      }
+
+      return std::max<size_t>(1, std::thread::hardware_concurrency());
     }
 
-    /**
-     * @brief   Remove column by name.
-     * @param   pColumnName           column label name.
-     */
-    void RemoveColumn(const std::string& pColumnName)
+    size_t GetLoadThreadCount() const
     {
-      int columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
+      if (mLoadParams.mThreads != 0)
       {
-        throw std::out_of_range("column not found: " + pColumnName);
+        return mLoadParams.mThreads;
       }
 
-      RemoveColumn(static_cast<size_t>(columnIdx));
+      return std::max<size_t>(1, std::thread::hardware_concurrency());
     }
 
-    /**
-     * @brief   Insert column at specified index.
-     * @param   pColumnIdx            zero-based column index.
-     * @param   pColumn               vector of column data (optional argument).
-     * @param   pColumnName           column label name (optional argument).
-     */
-    template<typename T>
-    void InsertColumn(const size_t pColumnIdx, const std::vector<T>& pColumn = std::vector<T>(),
-                      const std::string& pColumnName = std::string())
+    size_t GetDataRowCount() const
     {
-      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
+      return mArena.IsEmpty() ? mData.size() : mArena.GetRowCount();
+    }
 
-      std::vector<std::string> column;
-      if (pColumn.empty())
+    size_t GetDataRowSize(const size_t pDataRowIdx) const
+    {
+      return mArena.IsEmpty() ? mData.at(pDataRowIdx).size() : mArena.GetRowSize(pDataRowIdx);
+    }
+
+    // Returns reference to the stored cell, or to pBuffer holding a copy for arena storage.
+    template<typename T>
+    T ConvertDataCell(const Converter<T>& pConverter, const size_t pDataRowIdx, const size_t pDataColumnIdx) const
+    {
+      T val;
+      if (mArena.IsEmpty())
       {
-        column.resize(GetDataRowCount());
+        pConverter.ToVal(mData.at(pDataRowIdx).at(pDataColumnIdx), val);
       }
       else
       {
-        column.resize(GetDataRowIndex(pColumn.size()));
-        Converter<T> converter(mConverterParams);
-        for (auto itRow = pColumn.begin(); itRow != pColumn.end(); ++itRow)
-        {
-          std::string str;
-          converter.ToStr(*itRow, str);
-          const size_t rowIdx =
-            static_cast<size_t>(std::distance(pColumn.begin(), itRow) + (mLabelParams.mColumnNameIdx + 1));
-          column.at(rowIdx) = str;
-        }
+        // arena cells are copied to a string for conversion
+        std::string buffer;
+        mArena.GetCell(pDataRowIdx, pDataColumnIdx, buffer);
+        pConverter.ToVal(buffer, val);
       }
+      return val;
+    }
 
-      while (column.size() > GetDataRowCount())
+    const std::string& GetDataCell(const size_t pDataRowIdx, const size_t pDataColumnIdx,
+                                   std::string& pBuffer) const
+    {
+      if (mArena.IsEmpty())
       {
-        std::vector<std::string> row;
-        const size_t columnCount = std::max<size_t>(static_cast<size_t>(mLabelParams.mColumnNameIdx + 1),
-                                                    GetDataColumnCount());
-        row.resize(columnCount);
-        mData.push_back(row);
+        return mData.at(pDataRowIdx).at(pDataColumnIdx);
       }
 
-      for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
-      {
-        if (std::distance(mData.begin(), itRow) >= mLabelParams.mColumnNameIdx)
-        {
-          const size_t rowIdx = static_cast<size_t>(std::distance(mData.begin(), itRow));
-          if (dataColumnIdx <= itRow->size())
-          {
-            itRow->insert(itRow->begin() + static_cast<int>(dataColumnIdx), column.at(rowIdx));
-          }
-          else
-          {
-            const std::string errStr = "column out of range: " +
-              std::to_string(pColumnIdx) + " (on row " +
-              std::to_string(std::distance(mData.begin(), itRow)) +
-              ")";
-            throw std::out_of_range(errStr);
-          }
-        }
-      }
+      mArena.GetCell(pDataRowIdx, pDataColumnIdx, pBuffer);
+      return pBuffer;
+    }
 
-      if (!pColumnName.empty())
+    // Returns pointer to the stored cell text (not null-terminated), without copying.
+    const char* GetDataCell(const size_t pDataRowIdx, const size_t pDataColumnIdx, size_t& pLength) const
+    {
+      if (mArena.IsEmpty())
       {
-        SetColumnName(pColumnIdx, pColumnName);
+        const std::string& cell = mData.at(pDataRowIdx).at(pDataColumnIdx);
+        pLength = cell.size();
+        return cell.data();
       }
 
-      UpdateColumnNames();
+      return mArena.GetCell(pDataRowIdx, pDataColumnIdx, pLength);
     }
 
-    /**
-     * @brief   Get number of data columns (excluding label columns).
-     * @returns column count.
-     */
-    size_t GetColumnCount() const
+    void MakeMutable()
     {
-      const size_t firstRow = static_cast<size_t>((mLabelParams.mColumnNameIdx >= 0) ? mLabelParams.mColumnNameIdx : 0);
-      const int count = static_cast<int>((mData.size() > firstRow) ? mData.at(firstRow).size() : 0) -
-        (mLabelParams.mRowNameIdx + 1);
-      return (count >= 0) ? static_cast<size_t>(count) : 0;
+      // Convert arena storage to row storage prior to modification
+      if (!mArena.IsEmpty())
+      {
+        mArena.ToRows(mData);
+        mArena.Clear();
+      }
     }
 
-    /**
-     * @brief   Get row index by name.
-     * @param   pRowName              row label name.
-     * @returns zero-based row index.
-     */
-    int GetRowIdx(const std::string& pRowName) const
+    void InvalidateColumnCache()
     {
-      if (mLabelParams.mRowNameIdx >= 0)
-      {
-        if (mRowNames.find(pRowName) != mRowNames.end())
-        {
-          return static_cast<int>(mRowNames.at(pRowName)) - (mLabelParams.mColumnNameIdx + 1);
-        }
-      }
-      return -1;
+      mColumnCache.clear();
     }
 
-    /**
-     * @brief   Get row by index.
-     * @param   pRowIdx               zero-based row index.
-     * @returns vector of row data.
-     */
-    template<typename T>
-    std::vector<T> GetRow(const size_t pRowIdx) const
+    void InvalidateColumnCache(const size_t pColumnIdx, const bool pFollowingColumns)
     {
-      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
-      std::vector<T> row;
-      Converter<T> converter(mConverterParams);
-      for (auto itCol = mData.at(dataRowIdx).begin(); itCol != mData.at(dataRowIdx).end(); ++itCol)
+      for (auto itEntry = mColumnCache.begin(); itEntry != mColumnCache.end();)
       {
-        if (std::distance(mData.at(dataRowIdx).begin(), itCol) > mLabelParams.mRowNameIdx)
+        const size_t columnIdx = itEntry->first.first;
+        if ((columnIdx == pColumnIdx) || (pFollowingColumns && (columnIdx > pColumnIdx)))
         {
-          T val;
-          converter.ToVal(*itCol, val);
-          row.push_back(val);
+          itEntry = mColumnCache.erase(itEntry);
+        }
+        else
+        {
+          ++itEntry;
         }
       }
-      return row;
     }
 
-    /**
-     * @brief   Get row by index.
-     * @param   pRowIdx               zero-based row index.
-     * @param   pToVal                conversion function.
-     * @returns vector of row data.
-     */
-    template<typename T>
-    std::vector<T> GetRow(const size_t pRowIdx, ConvFunc<T> pToVal) const
+    size_t GetDataColumnCount() const
     {
-      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
-      std::vector<T> row;
-      Converter<T> converter(mConverterParams);
-      for (auto itCol = mData.at(dataRowIdx).begin(); itCol != mData.at(dataRowIdx).end(); ++itCol)
-      {
-        if (std::distance(mData.at(dataRowIdx).begin(), itCol) > mLabelParams.mRowNameIdx)
-        {
-          T val;
-          pToVal(*itCol, val);
-          row.push_back(val);
-        }
-      }
-      return row;
+      const size_t firstDataRow =
+        static_cast<size_t>((mLabelParams.mColumnNameIdx >= 0) ? mLabelParams.mColumnNameIdx : 0);
+      return (GetDataRowCount() > firstDataRow) ? GetDataRowSize(firstDataRow) : 0;
     }
 
-    /**
-     * @brief   Get row by name.
-     * @param   pRowName              row label name.
-     * @returns vector of row data.
-     */
-    template<typename T>
-    std::vector<T> GetRow(const std::string& pRowName) const
+    inline size_t GetDataRowIndex(const size_t pRowIdx) const
     {
-      int rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
-      {
-        throw std::out_of_range("row not found: " + pRowName);
-      }
-      return GetRow<T>(static_cast<size_t>(rowIdx));
+      const size_t firstDataRow =
+        static_cast<size_t>((mLabelParams.mColumnNameIdx + 1 >= 0) ? mLabelParams.mColumnNameIdx + 1 : 0);
+      return pRowIdx + firstDataRow;
     }
 
-    /**
-     * @brief   Get row by name.
-     * @param   pRowName              row label name.
-     * @param   pToVal                conversion function.
-     * @returns vector of row data.
-     */
-    template<typename T>
-    std::vector<T> GetRow(const std::string& pRowName, ConvFunc<T> pToVal) const
+    inline size_t GetDataColumnIndex(const size_t pColumnIdx) const
     {
-      int rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
-      {
-        throw std::out_of_range("row not found: " + pRowName);
-      }
-      return GetRow<T>(static_cast<size_t>(rowIdx), pToVal);
+      const size_t firstDataColumn =
+        static_cast<size_t>((mLabelParams.mRowNameIdx + 1 >= 0) ? mLabelParams.mRowNameIdx + 1 : 0);
+      return pColumnIdx + firstDataColumn;
     }
 
-    /**
-     * @brief   Set row by index.
-     * @param   pRowIdx               zero-based row index.
-     * @param   pRow                  vector of row data.
-     */
-    template<typename T>
-    void SetRow(const size_t pRowIdx, const std::vector<T>& pRow)
+    size_t PrepareColumn(const size_t pColumnIdx, const size_t pRowCount)
     {
-      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+      MakeMutable();
+      SetModified(0);
+      InvalidateColumnCache(pColumnIdx, false);
+      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
 
-      while ((dataRowIdx + 1) > GetDataRowCount())
+      while (GetDataRowIndex(pRowCount) > GetDataRowCount())
       {
-        std::vector<std::string> row;
-        row.resize(GetDataColumnCount());
-        mData.push_back(row);
+        InvalidateColumnCache();
+        mData.push_back(MakeEmptyRow(GetDataColumnCount()));
       }
 
-      if (pRow.size() > GetDataColumnCount())
+      if ((dataColumnIdx + 1) > GetDataColumnCount())
       {
         for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
         {
           if (std::distance(mData.begin(), itRow) >= mLabelParams.mColumnNameIdx)
           {
-            itRow->resize(GetDataColumnIndex(pRow.size()));
+            itRow->resize(GetDataColumnIndex(dataColumnIdx + 1));
           }
         }
       }
 
-      Converter<T> converter(mConverterParams);
-      for (auto itCol = pRow.begin(); itCol != pRow.end(); ++itCol)
-      {
-        std::string str;
-        converter.ToStr(*itCol, str);
-        mData.at(dataRowIdx).at(static_cast<size_t>(std::distance(pRow.begin(),
-                                                                  itCol) + mLabelParams.mRowNameIdx + 1)) = str;
-      }
-    }
-
-    /**
-     * @brief   Set row by name.
-     * @param   pRowName              row label name.
-     * @param   pRow                  vector of row data.
-     */
-    template<typename T>
-    void SetRow(const std::string& pRowName, const std::vector<T>& pRow)
-    {
-      int rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
-      {
-        throw std::out_of_range("row not found: " + pRowName);
-      }
-      return SetRow<T>(static_cast<size_t>(rowIdx), pRow);
+      return dataColumnIdx;
     }
 
-    /**
-     * @brief   Remove row by index.
-     * @param   pRowIdx               zero-based row index.
-     */
-    void RemoveRow(const size_t pRowIdx)
+    // Returns row of pSize empty cells, with storage for at least the reserved column count.
+    std::vector<std::string> MakeEmptyRow(const size_t pSize) const
     {
-      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
-      if (dataRowIdx < mData.size())
-      {
-        mData.erase(mData.begin() + static_cast<int>(dataRowIdx));
-      }
-      else
-      {
-        const std::string errStr = "row out of range: " +
-          std::to_string(pRowIdx);
-        throw std::out_of_range(errStr);
-      }
-
-      UpdateRowNames();
+      std::vector<std::string> row;
+      row.reserve(std::max(pSize, mColumnCapacity));
+      row.resize(pSize);
+      return row;
     }
 
-    /**
-     * @brief   Remove row by name.
-     * @param   pRowName              row label name.
-     */
-    void RemoveRow(const std::string& pRowName)
-    {
-      int rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
+    // Returns row with data cells moved from pRow, preceded by empty row label cells.
+    std::vector<std::string> MakeDataRow(std::vector<std::string>&& pRow) const
+    {
+      const size_t firstColumnIdx = GetDataColumnIndex(0);
+      if (pRow.empty())
       {
-        throw std::out_of_range("row not found: " + pRowName);
+        return MakeEmptyRow(GetDataColumnCount());
+      }
+      else if (firstColumnIdx == 0)
+      {
+        return std::move(pRow);
       }
 
-      RemoveRow(static_cast<size_t>(rowIdx));
+      std::vector<std::string> row;
+      row.reserve(firstColumnIdx + pRow.size());
+      row.resize(firstColumnIdx);
+      std::move(pRow.begin(), pRow.end(), std::back_inserter(row));
+      return row;
     }
 
-    /**
-     * @brief   Insert row at specified index.
-     * @param   pRowIdx               zero-based row index.
-     * @param   pRow                  vector of row data (optional argument).
-     * @param   pRowName              row label name (optional argument).
-     */
-    template<typename T>
-    void InsertRow(const size_t pRowIdx, const std::vector<T>& pRow = std::vector<T>(),
-                   const std::string& pRowName = std::string())
+    void InsertDataRow(const size_t pRowIdx, std::vector<std::string>&& pRow, const std::string& pRowName)
     {
+      MakeMutable();
+      InvalidateColumnCache();
       const size_t rowIdx = GetDataRowIndex(pRowIdx);
+      SetModified(rowIdx);
 
-      std::vector<std::string> row;
-      if (pRow.empty())
-      {
-        row.resize(GetDataColumnCount());
-      }
-      else
+      if (rowIdx > GetDataRowCount())
       {
-        row.resize(GetDataColumnIndex(pRow.size()));
-        Converter<T> converter(mConverterParams);
-        for (auto itCol = pRow.begin(); itCol != pRow.end(); ++itCol)
-        {
-          std::string str;
-          converter.ToStr(*itCol, str);
-          row.at(static_cast<size_t>(std::distance(pRow.begin(), itCol) + mLabelParams.mRowNameIdx + 1)) = str;
-        }
+        // padding rows all get empty labels, rebuild row names on next lookup
+        mRowNames.Reset();
       }
 
       while (rowIdx > GetDataRowCount())
       {
-        std::vector<std::string> tempRow;
-        tempRow.resize(GetDataColumnCount());
-        mData.push_back(tempRow);
+        mData.push_back(MakeEmptyRow(GetDataColumnCount()));
       }
 
-      mData.insert(mData.begin() + static_cast<int>(rowIdx), row);
+      mData.insert(mData.begin() + static_cast<int>(rowIdx), std::move(pRow));
+      InsertRowName(rowIdx);
 
       if (!pRowName.empty())
       {
         SetRowName(pRowIdx, pRowName);
       }
-
-      UpdateRowNames();
     }
 
-    /**
-     * @brief   Get number of data rows (excluding label rows).
-     * @returns row count.
-     */
-    size_t GetRowCount() const
+    void RemoveDataColumns(const std::vector<bool>& pRemove)
     {
-      const int count = static_cast<int>(mData.size()) - (mLabelParams.mColumnNameIdx + 1);
-      return (count >= 0) ? static_cast<size_t>(count) : 0;
-    }
+      const auto itFirst = std::find(pRemove.begin(), pRemove.end(), true);
+      if (itFirst == pRemove.end())
+      {
+        return;
+      }
 
-    /**
-     * @brief   Get cell by index.
-     * @param   pColumnIdx            zero-based column index.
-     * @param   pRowIdx               zero-based row index.
-     * @returns cell data.
-     */
-    template<typename T>
-    T GetCell(const size_t pColumnIdx, const size_t pRowIdx) const
-    {
-      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
-      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+      MakeMutable();
 
-      T val;
-      Converter<T> converter(mConverterParams);
-      converter.ToVal(mData.at(dataRowIdx).at(dataColumnIdx), val);
-      return val;
-    }
+      // check all rows before modifying any, only the last removed column must exist in each
+      const size_t lastColumnIdx =
+        static_cast<size_t>(std::distance(std::find(pRemove.rbegin(), pRemove.rend(), true), pRemove.rend())) - 1;
+      const size_t firstRow = static_cast<size_t>(std::max(0, mLabelParams.mColumnNameIdx));
+      for (size_t rowIdx = firstRow; rowIdx < mData.size(); ++rowIdx)
+      {
+        if (lastColumnIdx >= mData[rowIdx].size())
+        {
+          const std::string errStr = "column out of range: " +
+            std::to_string(lastColumnIdx - GetDataColumnIndex(0)) + " (on row " +
+            std::to_string(rowIdx) + ")";
+          throw std::out_of_range(errStr);
+        }
+      }
 
-    /**
-     * @brief   Get cell by index.
-     * @param   pColumnIdx            zero-based column index.
-     * @param   pRowIdx               zero-based row index.
-     * @param   pToVal                conversion function.
-     * @returns cell data.
-     */
-    template<typename T>
-    T GetCell(const size_t pColumnIdx, const size_t pRowIdx, ConvFunc<T> pToVal) const
-    {
-      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
-      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+      const size_t firstColumnIdx = static_cast<size_t>(std::distance(pRemove.begin(), itFirst));
+      InvalidateColumnCache(firstColumnIdx - GetDataColumnIndex(0), true);
+      SetModified(0);
+      for (size_t rowIdx = firstRow; rowIdx < mData.size(); ++rowIdx)
+      {
+        std::vector<std::string>& row = mData[rowIdx];
+        size_t dstIdx = firstColumnIdx;
+        for (size_t srcIdx = firstColumnIdx + 1; srcIdx < row.size(); ++srcIdx)
+        {
+          if ((srcIdx >= pRemove.size()) || !pRemove[srcIdx])
+          {
+            row[dstIdx++].swap(row[srcIdx]);
+          }
+        }
+        row.resize(dstIdx);
+      }
 
-      T val;
-      pToVal(mData.at(dataRowIdx).at(dataColumnIdx), val);
-      return val;
+      UpdateColumnNames();
     }
 
-    /**
-     * @brief   Get cell by name.
-     * @param   pColumnName           column label name.
-     * @param   pRowName              row label name.
-     * @returns cell data.
-     */
-    template<typename T>
-    T GetCell(const std::string& pColumnName, const std::string& pRowName) const
+    void RemoveDataRows(const std::vector<bool>& pRemove)
     {
-      const int columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
+      const auto itFirst = std::find(pRemove.begin(), pRemove.end(), true);
+      if (itFirst == pRemove.end())
       {
-        throw std::out_of_range("column not found: " + pColumnName);
+        return;
       }
 
-      const int rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
+      MakeMutable();
+      InvalidateColumnCache();
+      size_t dstIdx = static_cast<size_t>(std::distance(pRemove.begin(), itFirst));
+      SetModified(dstIdx);
+      for (size_t srcIdx = dstIdx + 1; srcIdx < mData.size(); ++srcIdx)
       {
-        throw std::out_of_range("row not found: " + pRowName);
+        if ((srcIdx >= pRemove.size()) || !pRemove[srcIdx])
+        {
+          mData[dstIdx++].swap(mData[srcIdx]);
+        }
       }
+      mData.resize(dstIdx);
 
-      return GetCell<T>(static_cast<size_t>(columnIdx), static_cast<size_t>(rowIdx));
+      // row names are indexed again on next lookup
+      mRowNames.Reset();
     }
 
-    /**
-     * @brief   Get cell by name.
-     * @param   pColumnName           column label name.
-     * @param   pRowName              row label name.
-     * @param   pToVal                conversion function.
-     * @returns cell data.
-     */
-    template<typename T>
-    T GetCell(const std::string& pColumnName, const std::string& pRowName, ConvFunc<T> pToVal) const
+    void UpdateColumnNames()
     {
-      const int columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
+      mColumnNames.Clear();
+      if ((mLabelParams.mColumnNameIdx >= 0) &&
+          (static_cast<int>(GetDataRowCount()) > mLabelParams.mColumnNameIdx))
       {
-        throw std::out_of_range("column not found: " + pColumnName);
+        const size_t dataRowIdx = static_cast<size_t>(mLabelParams.mColumnNameIdx);
+        const size_t rowSize = GetDataRowSize(dataRowIdx);
+        std::string buffer;
+        mColumnNames.Reserve(rowSize);
+        for (size_t i = 0; i < rowSize; ++i)
+        {
+          mColumnNames.Set(GetDataCell(dataRowIdx, i, buffer), i);
+        }
       }
+    }
 
-      const int rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
+    void BuildRowNames(detail::LabelIndex& pRowNames) const
+    {
+      if ((mLabelParams.mRowNameIdx >= 0) &&
+          (static_cast<int>(GetDataRowCount()) >
+           (mLabelParams.mColumnNameIdx + 1)))
       {
-        throw std::out_of_range("row not found: " + pRowName);
+        const size_t rowNameIdx = static_cast<size_t>(mLabelParams.mRowNameIdx);
+        const size_t rowCount = GetDataRowCount();
+        std::string buffer;
+        pRowNames.Reserve(rowCount);
+        for (size_t dataRowIdx = 0; dataRowIdx < rowCount; ++dataRowIdx)
+        {
+          if (GetDataRowSize(dataRowIdx) > rowNameIdx)
+          {
+            pRowNames.Set(GetDataCell(dataRowIdx, rowNameIdx, buffer), dataRowIdx);
+          }
+        }
       }
-
-      return GetCell<T>(static_cast<size_t>(columnIdx), static_cast<size_t>(rowIdx), pToVal);
     }
 
-    /**
-     * @brief   Get cell by column name and row index.
-     * @param   pColumnName           column label name.
-     * @param   pRowIdx               zero-based row index.
-     * @returns cell data.
-     */
-    template<typename T>
-    T GetCell(const std::string& pColumnName, const size_t pRowIdx) const
+    void RemoveRowName(const size_t pDataRowIdx)
     {
-      const int columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
+      detail::LabelIndex* rowNames = mRowNames.GetIfBuilt();
+      if (rowNames == nullptr)
       {
-        throw std::out_of_range("column not found: " + pColumnName);
+        return;
       }
 
-      return GetCell<T>(static_cast<size_t>(columnIdx), pRowIdx);
+      if (rowNames->HasDuplicates())
+      {
+        // a removed duplicate may uncover an earlier row with the same label
+        mRowNames.Reset();
+        return;
+      }
+
+      const size_t rowNameIdx = static_cast<size_t>(mLabelParams.mRowNameIdx);
+      if (GetDataRowSize(pDataRowIdx) > rowNameIdx)
+      {
+        std::string buffer;
+        rowNames->Erase(GetDataCell(pDataRowIdx, rowNameIdx, buffer));
+      }
+      rowNames->OffsetValues(pDataRowIdx + 1, static_cast<size_t>(-1));
     }
 
-    /**
-     * @brief   Get cell by column name and row index.
-     * @param   pColumnName           column label name.
-     * @param   pRowIdx               zero-based row index.
-     * @param   pToVal                conversion function.
-     * @returns cell data.
-     */
-    template<typename T>
-    T GetCell(const std::string& pColumnName, const size_t pRowIdx, ConvFunc<T> pToVal) const
+    void InsertRowName(const size_t pDataRowIdx)
     {
-      const int columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
+      detail::LabelIndex* rowNames = mRowNames.GetIfBuilt();
+      if (rowNames == nullptr)
       {
-        throw std::out_of_range("column not found: " + pColumnName);
+        return;
       }
 
-      return GetCell<T>(static_cast<size_t>(columnIdx), pRowIdx, pToVal);
+      rowNames->OffsetValues(pDataRowIdx, 1);
+      const size_t rowNameIdx = static_cast<size_t>(mLabelParams.mRowNameIdx);
+      if (GetDataRowSize(pDataRowIdx) > rowNameIdx)
+      {
+        std::string buffer;
+        const std::string& rowName = GetDataCell(pDataRowIdx, rowNameIdx, buffer);
+        size_t rowIdx = 0;
+        if (rowNames->HasDuplicates() || rowNames->Find(rowName, rowIdx))
+        {
+          mRowNames.Reset();
+        }
+        else
+        {
+          rowNames->Set(rowName, pDataRowIdx);
+        }
+      }
+    }
+
+#ifdef HAS_CODECVT
+#if defined(_MSC_VER)
+#pragma warning (push)
+#pragma warning (disable: 4996)
+#endif
+    static std::string ToString(const std::wstring& pWStr)
+    {
+      return std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t>{ }.to_bytes(pWStr);
     }
 
+    static std::wstring ToWString(const std::string& pStr)
+    {
+      return std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t>{ }.from_bytes(pStr);
+    }
+#if defined(_MSC_VER)
+#pragma warning (pop)
+#endif
+#endif
+
+  private:
+    static const size_t sWriteBufferSize = 1024 * 1024;
+    static const size_t sSaveChunkRows = 16384;
+    std::string mPath;
+    LabelParams mLabelParams;
+    SeparatorParams mSeparatorParams;
+    ConverterParams mConverterParams;
+    detail::NumericLocale mNumericLocale;
+    LineReaderParams mLineReaderParams;
+    LoadParams mLoadParams;
+    std::vector<std::vector<std::string>> mData;
+    detail::ArenaTable mArena;
+    std::map<std::pair<size_t, std::type_index>, std::shared_ptr<detail::ColumnCacheEntry>> mColumnCache;
+    detail::LabelIndex mColumnNames;
+    detail::LazyLabelIndex mRowNames;
+    std::string mSavedPath;
+    size_t mSavedRowCount;
+    int64_t mSavedSize;
+    int64_t mSavedTime;
+    size_t mColumnCapacity;
+#ifdef HAS_CODECVT
+    bool mIsUtf16 = false;
+    bool mIsLE = false;
+#endif
+    bool mHasUtf8BOM = false;
+  };
+
+  /**
+   * @brief     Class for push parsing of CSV data. Cells and row ends are passed to a handler
+   *            as they are parsed, without building any row or cell objects. The handler
+   *            must provide the member functions OnCell(const char* pData, size_t pLength),
+   *            receiving the cell text (trimmed and unquoted as configured, not
+   *            null-terminated, valid only during the call), and OnRowEnd(). Skipped empty and
+   *            comment lines result in no handler calls. UTF-16 data is not supported.
+   */
+  class Parser
+  {
+  public:
     /**
-     * @brief   Get cell by column index and row name.
-     * @param   pColumnIdx            zero-based column index.
-     * @param   pRowName              row label name.
-     * @returns cell data.
+     * @brief   Constructor
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
      */
-    template<typename T>
-    T GetCell(const size_t pColumnIdx, const std::string& pRowName) const
+    explicit Parser(const SeparatorParams& pSeparatorParams = SeparatorParams(),
+                    const LineReaderParams& pLineReaderParams = LineReaderParams())
+      : mSeparatorParams(pSeparatorParams)
+      , mLineReaderParams(pLineReaderParams)
     {
-      const int rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
-      {
-        throw std::out_of_range("row not found: " + pRowName);
-      }
-
-      return GetCell<T>(pColumnIdx, static_cast<size_t>(rowIdx));
     }
 
     /**
-     * @brief   Get cell by column index and row name.
-     * @param   pColumnIdx            zero-based column index.
-     * @param   pRowName              row label name.
-     * @param   pToVal                conversion function.
-     * @returns cell data.
+     * @brief   Parse CSV file.
+     * @param   pPath                 specifies the path of an existing CSV-file to parse.
+     * @param   pHandler              handler receiving cells and row ends.
      */
-    template<typename T>
-    T GetCell(const size_t pColumnIdx, const std::string& pRowName, ConvFunc<T> pToVal) const
+    template<typename THandler>
+    void Parse(const std::string& pPath, THandler& pHandler) const
     {
-      const int rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
-      {
-        throw std::out_of_range("row not found: " + pRowName);
-      }
+      std::ifstream stream;
+      stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+      stream.open(pPath, std::ios::binary);
 
-      return GetCell<T>(pColumnIdx, static_cast<size_t>(rowIdx), pToVal);
+      // reading past end of file sets failbit, which is expected here
+      stream.exceptions(std::ifstream::badbit);
+      Parse(stream, pHandler);
     }
 
     /**
-     * @brief   Set cell by index.
-     * @param   pRowIdx               zero-based row index.
-     * @param   pColumnIdx            zero-based column index.
-     * @param   pCell                 cell data.
+     * @brief   Parse CSV data from stream.
+     * @param   pStream               specifies a binary input stream to read CSV data from. The
+     *                                stream is not required to be seekable.
+     * @param   pHandler              handler receiving cells and row ends.
      */
-    template<typename T>
-    void SetCell(const size_t pColumnIdx, const size_t pRowIdx, const T& pCell)
+    template<typename THandler>
+    void Parse(std::istream& pStream, THandler& pHandler) const
     {
-      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
-      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+      const std::streamsize bufLength = 64 * 1024;
+      std::vector<char> buffer(bufLength);
+      detail::Tokenizer tokenizer(mSeparatorParams, mLineReaderParams);
+      bool first = true;
 
-      while ((dataRowIdx + 1) > GetDataRowCount())
+      while (true)
       {
-        std::vector<std::string> row;
-        row.resize(GetDataColumnCount());
-        mData.push_back(row);
-      }
+        pStream.read(buffer.data(), bufLength);
+        const std::streamsize readLength = pStream.gcount();
+        if (readLength <= 0)
+        {
+          break;
+        }
 
-      if ((dataColumnIdx + 1) > GetDataColumnCount())
-      {
-        for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
+        size_t pos = 0;
+        if (first)
         {
-          if (std::distance(mData.begin(), itRow) >= mLabelParams.mColumnNameIdx)
+          // check for UTF-8 Byte order mark and skip it when found
+          first = false;
+          if ((readLength >= 3) && std::equal(s_Utf8BOM.begin(), s_Utf8BOM.end(), buffer.data()))
           {
-            itRow->resize(dataColumnIdx + 1);
+            pos = 3;
           }
         }
+
+        tokenizer.Parse(buffer.data() + pos, static_cast<size_t>(readLength) - pos, pHandler);
       }
 
-      std::string str;
-      Converter<T> converter(mConverterParams);
-      converter.ToStr(pCell, str);
-      mData.at(dataRowIdx).at(dataColumnIdx) = str;
+      // Handle last row / cell without linebreak
+      tokenizer.Finish(pHandler);
     }
 
     /**
-     * @brief   Set cell by name.
-     * @param   pColumnName           column label name.
-     * @param   pRowName              row label name.
-     * @param   pCell                 cell data.
+     * @brief   Parse CSV data in memory.
+     * @param   pData                 CSV data.
+     * @param   pLength               length of CSV data.
+     * @param   pHandler              handler receiving cells and row ends.
      */
-    template<typename T>
-    void SetCell(const std::string& pColumnName, const std::string& pRowName, const T& pCell)
+    template<typename THandler>
+    void Parse(const char* pData, size_t pLength, THandler& pHandler) const
     {
-      const int columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
+      // check for UTF-8 Byte order mark and skip it when found
+      if ((pLength >= 3) && std::equal(s_Utf8BOM.begin(), s_Utf8BOM.end(), pData))
       {
-        throw std::out_of_range("column not found: " + pColumnName);
+        pData += 3;
+        pLength -= 3;
       }
 
-      const int rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
-      {
-        throw std::out_of_range("row not found: " + pRowName);
-      }
+      detail::Tokenizer tokenizer(mSeparatorParams, mLineReaderParams);
+      tokenizer.Parse(pData, pLength, pHandler);
 
-      SetCell<T>(static_cast<size_t>(columnIdx), static_cast<size_t>(rowIdx), pCell);
+      // Handle last row / cell without linebreak
+      tokenizer.Finish(pHandler);
     }
 
+  private:
+    SeparatorParams mSeparatorParams;
+    LineReaderParams mLineReaderParams;
+  };
+
+  /**
+   * @brief     Class for reading CSV data one row at a time, without storing the document.
+   *            Memory usage is independent of the data size, and buffers are reused between
+   *            rows. UTF-16 data is not supported.
+   */
+  class Reader
+  {
+  public:
     /**
-     * @brief   Set cell by column index and row name.
-     * @param   pColumnIdx            zero-based column index.
-     * @param   pRowName              row label name.
-     * @param   pCell                 cell data.
+     * @brief   Constructor
+     * @param   pPath                 specifies the path of an existing CSV-file to read.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
+     *                                handled.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
      */
-    template<typename T>
-    void SetCell(const size_t pColumnIdx, const std::string& pRowName, const T& pCell)
+    explicit Reader(const std::string& pPath,
+                    const SeparatorParams& pSeparatorParams = SeparatorParams(),
+                    const ConverterParams& pConverterParams = ConverterParams(),
+                    const LineReaderParams& pLineReaderParams = LineReaderParams())
+      : mFile()
+      , mStream(mFile)
+      , mConverterParams(pConverterParams)
+      , mNumericLocale()
+      , mTokenizer(pSeparatorParams, pLineReaderParams)
+      , mBuffer(sBufferLength)
+      , mPos(0)
+      , mEnd(0)
+      , mStarted(false)
+      , mFinished(false)
+      , mCells()
     {
-      const int rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
-      {
-        throw std::out_of_range("row not found: " + pRowName);
-      }
+      mFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+      mFile.open(pPath, std::ios::binary);
 
-      SetCell<T>(pColumnIdx, static_cast<size_t>(rowIdx), pCell);
+      // reading past end of file sets failbit, which is expected here
+      mFile.exceptions(std::ifstream::badbit);
     }
 
     /**
-     * @brief   Set cell by column name and row index.
-     * @param   pColumnName           column label name.
-     * @param   pRowIdx               zero-based row index.
-     * @param   pCell                 cell data.
+     * @brief   Constructor
+     * @param   pStream               specifies a binary input stream to read CSV data from. The
+     *                                stream is not required to be seekable.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
+     *                                handled.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
      */
-    template<typename T>
-    void SetCell(const std::string& pColumnName, const size_t pRowIdx, const T& pCell)
+    explicit Reader(std::istream& pStream,
+                    const SeparatorParams& pSeparatorParams = SeparatorParams(),
+                    const ConverterParams& pConverterParams = ConverterParams(),
+                    const LineReaderParams& pLineReaderParams = LineReaderParams())
+      : mFile()
+      , mStream(pStream)
+      , mConverterParams(pConverterParams)
+      , mNumericLocale()
+      , mTokenizer(pSeparatorParams, pLineReaderParams)
+      , mBuffer(sBufferLength)
+      , mPos(0)
+      , mEnd(0)
+      , mStarted(false)
+      , mFinished(false)
+      , mCells()
     {
-      const int columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
-      {
-        throw std::out_of_range("column not found: " + pColumnName);
-      }
-
-      SetCell<T>(static_cast<size_t>(columnIdx), pRowIdx, pCell);
     }
 
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
     /**
-     * @brief   Get column name
-     * @param   pColumnIdx            zero-based column index.
-     * @returns column name.
+     * @brief   Read next row. Label rows and columns are not treated specially, i.e. they are
+     *          returned as regular rows and cells.
+     * @param   pRow                  vector receiving the row cells. Its elements are reused,
+     *                                so passing the same vector for each row avoids allocations.
+     * @returns true if a row was read, false at end of data.
      */
-    std::string GetColumnName(const size_t pColumnIdx) const
+    bool Next(std::vector<std::string>& pRow)
     {
-      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
-      if (mLabelParams.mColumnNameIdx < 0)
+      detail::RowBuilder builder(pRow);
+      while (!mFinished)
       {
-        throw std::out_of_range("column name row index < 0: " + std::to_string(mLabelParams.mColumnNameIdx));
+        if (mPos < mEnd)
+        {
+          mPos += mTokenizer.Parse(mBuffer.data() + mPos, mEnd - mPos, builder, true /* pStopAtRowEnd */);
+          if (builder.IsRowDone())
+          {
+            return true;
+          }
+        }
+        else if (!Fill())
+        {
+          // Handle last row / cell without linebreak
+          mFinished = true;
+          return mTokenizer.Finish(builder);
+        }
       }
 
-      return mData.at(static_cast<size_t>(mLabelParams.mColumnNameIdx)).at(dataColumnIdx);
+      return false;
     }
 
     /**
-     * @brief   Set column name
-     * @param   pColumnIdx            zero-based column index.
-     * @param   pColumnName           column name.
+     * @brief   Read next row, converting its cells.
+     * @param   pRow                  vector receiving the converted row cells.
+     * @returns true if a row was read, false at end of data.
      */
-    void SetColumnName(size_t pColumnIdx, const std::string& pColumnName)
+    template<typename T>
+    bool Next(std::vector<T>& pRow)
     {
-      if (mLabelParams.mColumnNameIdx < 0)
+      if (!Next(mCells))
       {
-        throw std::out_of_range("column name row index < 0: " + std::to_string(mLabelParams.mColumnNameIdx));
+        return false;
       }
 
-      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
-      mColumnNames[pColumnName] = dataColumnIdx;
-
-      // increase table size if necessary:
-      const size_t rowIdx = static_cast<size_t>(mLabelParams.mColumnNameIdx);
-      if (rowIdx >= mData.size())
-      {
-        mData.resize(rowIdx + 1);
-      }
-      auto& row = mData[rowIdx];
-      if (dataColumnIdx >= row.size())
+      pRow.clear();
+      Converter<T> converter(mConverterParams, mNumericLocale);
+      for (const auto& cell : mCells)
       {
-        row.resize(dataColumnIdx + 1);
+        T val;
+        converter.ToVal(cell, val);
+        pRow.push_back(val);
       }
-
-      mData.at(static_cast<size_t>(mLabelParams.mColumnNameIdx)).at(dataColumnIdx) = pColumnName;
+      return true;
     }
 
     /**
-     * @brief   Get column names
-     * @returns vector of column names.
+     * @brief   Count the rows of a CSV-file, without storing any cells. Rows are counted as
+     *          when loading, including label rows, and excluding skipped comment and empty lines.
+     * @param   pPath                 specifies the path of an existing CSV-file.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @returns row count.
      */
-    std::vector<std::string> GetColumnNames() const
+    static size_t CountRows(const std::string& pPath,
+                            const SeparatorParams& pSeparatorParams = SeparatorParams(),
+                            const LineReaderParams& pLineReaderParams = LineReaderParams())
     {
-      if (mLabelParams.mColumnNameIdx >= 0)
+      if (pSeparatorParams.mQuotedLinebreaks || pLineReaderParams.mSkipCommentLines)
       {
-        return std::vector<std::string>(mData.at(static_cast<size_t>(mLabelParams.mColumnNameIdx)).begin() +
-                                        (mLabelParams.mRowNameIdx + 1),
-                                        mData.at(static_cast<size_t>(mLabelParams.mColumnNameIdx)).end());
+        // row ends depend on quoting, and comments on the first cell of each row
+        detail::RowCounter counter;
+        const Parser parser(pSeparatorParams, pLineReaderParams);
+        parser.Parse(pPath, counter);
+        return counter.GetCount();
       }
 
-      return std::vector<std::string>();
-    }
+      std::ifstream stream;
+      stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+      stream.open(pPath, std::ios::binary);
 
-    /**
-     * @brief   Get row name
-     * @param   pRowIdx               zero-based column index.
-     * @returns row name.
-     */
-    std::string GetRowName(const size_t pRowIdx) const
-    {
-      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
-      if (mLabelParams.mRowNameIdx < 0)
+      // reading past end of file sets failbit, which is expected here
+      stream.exceptions(std::ifstream::badbit);
+
+      // otherwise every linebreak ends a row, and a line is empty if it has nothing but CRs
+      std::vector<char> buffer(sBufferLength);
+      size_t count = 0;
+      bool lineEmpty = true;
+      bool first = true;
+      while (true)
       {
-        throw std::out_of_range("row name column index < 0: " + std::to_string(mLabelParams.mRowNameIdx));
-      }
+        stream.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        const std::streamsize readLength = stream.gcount();
+        if (readLength <= 0)
+        {
+          break;
+        }
 
-      return mData.at(dataRowIdx).at(static_cast<size_t>(mLabelParams.mRowNameIdx));
-    }
+        const char* pos = buffer.data();
+        const char* const end = pos + readLength;
+        if (first)
+        {
+          // check for UTF-8 Byte order mark and skip it when found
+          first = false;
+          if ((readLength >= 3) && std::equal(s_Utf8BOM.begin(), s_Utf8BOM.end(), pos))
+          {
+            pos += 3;
+          }
+        }
 
-    /**
-     * @brief   Set row name
-     * @param   pRowIdx               zero-based row index.
-     * @param   pRowName              row name.
-     */
-    void SetRowName(size_t pRowIdx, const std::string& pRowName)
-    {
-      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
-      mRowNames[pRowName] = dataRowIdx;
-      if (mLabelParams.mRowNameIdx < 0)
-      {
-        throw std::out_of_range("row name column index < 0: " + std::to_string(mLabelParams.mRowNameIdx));
-      }
+        while (pos < end)
+        {
+          const char* lf = static_cast<const char*>(std::memchr(pos, '\n', static_cast<size_t>(end - pos)));
+          const char* const lineEnd = (lf != nullptr) ? lf : end;
+          lineEmpty = lineEmpty && std::all_of(pos, lineEnd, [](const char pCh) { return pCh == '\r'; });
+          if (lf == nullptr)
+          {
+            break;
+          }
 
-      // increase table size if necessary:
-      if (dataRowIdx >= mData.size())
-      {
-        mData.resize(dataRowIdx + 1);
+          if (!lineEmpty || !pLineReaderParams.mSkipEmptyLines)
+          {
+            ++count;
+          }
+
+          lineEmpty = true;
+          pos = lf + 1;
+        }
       }
-      auto& row = mData[dataRowIdx];
-      if (mLabelParams.mRowNameIdx >= static_cast<int>(row.size()))
+
+      // last row without linebreak
+      if (!lineEmpty)
       {
-        row.resize(static_cast<size_t>(mLabelParams.mRowNameIdx) + 1);
+        ++count;
       }
 
-      mData.at(dataRowIdx).at(static_cast<size_t>(mLabelParams.mRowNameIdx)) = pRowName;
+      return count;
     }
 
     /**
-     * @brief   Get row names
-     * @returns vector of row names.
+     * @brief   Read the first row of a CSV-file, typically holding the column labels, without
+     *          reading the rest of the file. Skipped comment and empty lines are not returned.
+     * @param   pPath                 specifies the path of an existing CSV-file.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @returns vector of the first row cells, empty if the file has no rows.
      */
-    std::vector<std::string> GetRowNames() const
+    static std::vector<std::string> ReadHeader(const std::string& pPath,
+                                               const SeparatorParams& pSeparatorParams = SeparatorParams(),
+                                               const LineReaderParams& pLineReaderParams = LineReaderParams())
     {
-      std::vector<std::string> rownames;
-      if (mLabelParams.mRowNameIdx >= 0)
+      Reader reader(pPath, pSeparatorParams, ConverterParams(), pLineReaderParams);
+      std::vector<std::string> row;
+      reader.Next(row);
+      return row;
+    }
+
+  private:
+    bool Fill()
+    {
+      mStream.read(mBuffer.data(), static_cast<std::streamsize>(mBuffer.size()));
+      const std::streamsize readLength = mStream.gcount();
+      mPos = 0;
+      mEnd = (readLength > 0) ? static_cast<size_t>(readLength) : 0;
+
+      if (!mStarted)
       {
-        for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
+        // check for UTF-8 Byte order mark and skip it when found
+        mStarted = true;
+        if ((mEnd >= 3) && std::equal(s_Utf8BOM.begin(), s_Utf8BOM.end(), mBuffer.data()))
         {
-          if (std::distance(mData.begin(), itRow) > mLabelParams.mColumnNameIdx)
-          {
-            rownames.push_back(itRow->at(static_cast<size_t>(mLabelParams.mRowNameIdx)));
-          }
+          mPos = 3;
         }
       }
-      return rownames;
+
+      return mEnd > 0;
     }
 
   private:
-    void ReadCsv()
-    {
-      std::ifstream stream;
-      stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-      stream.open(mPath, std::ios::binary);
-      ReadCsv(stream);
-    }
+    static const size_t sBufferLength = 64 * 1024;
+    std::ifstream mFile;
+    std::istream& mStream;
+    ConverterParams mConverterParams;
+    detail::NumericLocale mNumericLocale;
+    detail::Tokenizer mTokenizer;
+    std::vector<char> mBuffer;
+    size_t mPos;
+    size_t mEnd;
+    bool mStarted;
+    bool mFinished;
+    std::vector<std::string> mCells;
+  };
 
-    void ReadCsv(std::istream& pStream)
+  /**
+   * @brief     Class for random access to the rows of a CSV-file, without loading it. The file is
+   *            scanned once to index the offset of every n-th row, after which a row is read by
+   *            seeking to the nearest preceding indexed row and parsing from there. Reading the
+   *            following row continues from the current position. Label rows and columns are not
+   *            treated specially. UTF-16 data is not supported.
+   */
+  class IndexedReader
+  {
+  public:
+    /**
+     * @brief   Constructor
+     * @param   pPath                 specifies the path of an existing CSV-file to read.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
+     *                                handled.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @param   pIndexParams          specifies how rows should be indexed.
+     */
+    explicit IndexedReader(const std::string& pPath,
+                           const SeparatorParams& pSeparatorParams = SeparatorParams(),
+                           const ConverterParams& pConverterParams = ConverterParams(),
+                           const LineReaderParams& pLineReaderParams = LineReaderParams(),
+                           const IndexParams& pIndexParams = IndexParams())
+      : mPath(pPath)
+      , mSeparatorParams(pSeparatorParams)
+      , mConverterParams(pConverterParams)
+      , mNumericLocale()
+      , mLineReaderParams(pLineReaderParams)
+      , mRowInterval(std::max<size_t>(1, pIndexParams.mRowInterval))
+      , mFile()
+      , mTokenizer(pSeparatorParams, pLineReaderParams)
+      , mBuffer(sBufferLength)
+      , mBufferOffset(0)
+      , mPos(0)
+      , mEnd(0)
+      , mFinished(false)
+      , mNextRowIdx(0)
+      , mRowCount(0)
+      , mOffsets()
+      , mCells()
     {
-      Clear();
-      pStream.seekg(0, std::ios::end);
-      std::streamsize length = pStream.tellg();
-      pStream.seekg(0, std::ios::beg);
+      mFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+      mFile.open(mPath, std::ios::binary);
 
-#ifdef HAS_CODECVT
-      std::vector<char> bom2b(2, '\0');
-      if (length >= 2)
+      // reading past end of file sets failbit, which is expected here
+      mFile.exceptions(std::ifstream::badbit);
+
+      int64_t size = 0;
+      int64_t time = 0;
+      const bool indexFile = pIndexParams.mIndexFile && detail::GetFileStamp(mPath, size, time);
+      if (indexFile && ReadIndex(size, time))
       {
-        pStream.read(bom2b.data(), 2);
-        pStream.seekg(0, std::ios::beg);
+        return;
       }
 
-      static const std::vector<char> bomU16le = { '\xff', '\xfe' };
-      static const std::vector<char> bomU16be = { '\xfe', '\xff' };
-      if ((bom2b == bomU16le) || (bom2b == bomU16be))
-      {
-        mIsUtf16 = true;
-        mIsLE = (bom2b == bomU16le);
+      BuildIndex();
 
-        std::vector<char> buffer(static_cast<size_t>(length));
-        pStream.read(buffer.data(), length);
+      // only store the index if the file was not modified while scanning it
+      int64_t newSize = 0;
+      int64_t newTime = 0;
+      if (indexFile && detail::GetFileStamp(mPath, newSize, newTime) && (newSize == size) && (newTime == time))
+      {
+        WriteIndex(size, time);
+      }
+    }
 
-        const std::wstring& utf16 = [&]()
-        {
-          if (mIsLE)
-          {
-            const std::codecvt_mode mode =
-              static_cast<std::codecvt_mode>(std::consume_header | std::little_endian);
-            std::wstring_convert<std::codecvt_utf16<wchar_t, 0x10ffff, mode>> utf16conv;
-            return utf16conv.from_bytes(buffer.data(), buffer.data() + length);
-          }
-          else
-          {
-            const std::codecvt_mode mode =
-              static_cast<std::codecvt_mode>(std::consume_header);
-            std::wstring_convert<std::codecvt_utf16<wchar_t, 0x10ffff, mode>> utf16conv;
-            return utf16conv.from_bytes(buffer.data(), buffer.data() + length);
-          }
-        }();
+    IndexedReader(const IndexedReader&) = delete;
+    IndexedReader& operator=(const IndexedReader&) = delete;
 
-        std::wstringstream wss(utf16);
-        std::string utf8 = ToString(wss.str());
-        std::stringstream ss(utf8);
-        ParseCsv(ss, static_cast<std::streamsize>(utf8.size()));
-      }
-      else
-#endif
-      {
-        // check for UTF-8 Byte order mark and skip it when found
-        if (length >= 3)
-        {
-          std::vector<char> bom3b(3, '\0');
-          pStream.read(bom3b.data(), 3);
+    /**
+     * @brief   Get number of rows, including any label rows.
+     * @returns row count.
+     */
+    size_t GetRowCount() const
+    {
+      return mRowCount;
+    }
 
-          if (bom3b != s_Utf8BOM)
-          {
-            // file does not start with a UTF-8 Byte order mark
-            pStream.seekg(0, std::ios::beg);
-          }
-          else
-          {
-            // file did start with a UTF-8 Byte order mark, simply skip it
-            length -= 3;
-            mHasUtf8BOM = true;
-          }
-        }
+    /**
+     * @brief   Get row by index.
+     * @param   pRowIdx               zero-based row index, counting all rows including labels.
+     * @param   pRow                  vector receiving the row cells. Its elements are reused,
+     *                                so passing the same vector for each row avoids allocations.
+     */
+    void GetRow(const size_t pRowIdx, std::vector<std::string>& pRow)
+    {
+      if (pRowIdx >= mRowCount)
+      {
+        throw std::out_of_range("row out of range: " + std::to_string(pRowIdx));
+      }
 
-        ParseCsv(pStream, length);
+      // seek unless the row is ahead of the current position and no indexed row is closer
+      const size_t offsetIdx = pRowIdx / mRowInterval;
+      if ((pRowIdx < mNextRowIdx) || ((offsetIdx * mRowInterval) > mNextRowIdx))
+      {
+        Seek(offsetIdx);
+      }
+
+      while (mNextRowIdx < pRowIdx)
+      {
+        ReadRow(mCells);
       }
+      ReadRow(pRow);
     }
 
-    void ParseCsv(std::istream& pStream, std::streamsize p_FileLength)
+    /**
+     * @brief   Get row by index.
+     * @param   pRowIdx               zero-based row index, counting all rows including labels.
+     * @returns vector of row data.
+     */
+    template<typename T>
+    std::vector<T> GetRow(const size_t pRowIdx)
     {
-      const std::streamsize bufLength = 64 * 1024;
-      std::vector<char> buffer(bufLength);
-      std::vector<std::string> row;
-      std::string cell;
-      bool quoted = false;
-      int cr = 0;
-      int lf = 0;
+      GetRow(pRowIdx, mCells);
 
-      while (p_FileLength > 0)
+      std::vector<T> row;
+      row.reserve(mCells.size());
+      Converter<T> converter(mConverterParams, mNumericLocale);
+      for (const auto& cell : mCells)
       {
-        const std::streamsize toReadLength = std::min<std::streamsize>(p_FileLength, bufLength);
-        pStream.read(buffer.data(), toReadLength);
-
-        // With user-specified istream opened in non-binary mode on windows, we may have a
-        // data length mismatch, so ensure we don't parse outside actual data length read.
-        const std::streamsize readLength = pStream.gcount();
-        if (readLength <= 0)
-        {
-          break;
-        }
-
-        for (size_t i = 0; i < static_cast<size_t>(readLength); ++i)
-        {
-          if (buffer[i] == mSeparatorParams.mQuoteChar)
-          {
-            if (cell.empty() || (cell[0] == mSeparatorParams.mQuoteChar))
-            {
-              quoted = !quoted;
-            }
-            else if (mSeparatorParams.mTrim)
-            {
-              // allow whitespace before first mQuoteChar
-              const auto firstQuote = std::find(cell.begin(), cell.end(), mSeparatorParams.mQuoteChar);
-              if (std::all_of(cell.begin(), firstQuote, [](unsigned char ch) { return isspace(ch); }))
-              {
-                quoted = !quoted;
-              }
-            }
-            cell += buffer[i];
-          }
-          else if (buffer[i] == mSeparatorParams.mSeparator)
-          {
-            if (!quoted)
-            {
-              row.push_back(Unquote(Trim(cell)));
-              cell.clear();
-            }
-            else
-            {
-              cell += buffer[i];
-            }
-          }
-          else if (buffer[i] == '\r')
-          {
-            if (mSeparatorParams.mQuotedLinebreaks && quoted)
-            {
-              cell += buffer[i];
-            }
-            else
-            {
-              ++cr;
-            }
-          }
-          else if (buffer[i] == '\n')
-          {
-            if (mSeparatorParams.mQuotedLinebreaks && quoted)
-            {
-              cell += buffer[i];
-            }
-            else
-            {
-              ++lf;
-              if (mLineReaderParams.mSkipEmptyLines && row.empty() && cell.empty())
-              {
-                // skip empty line
-              }
-              else
-              {
-                row.push_back(Unquote(Trim(cell)));
-
-                if (mLineReaderParams.mSkipCommentLines && !row.at(0).empty() &&
-                    (row.at(0)[0] == mLineReaderParams.mCommentPrefix))
-                {
-                  // skip comment line
-                }
-                else
-                {
-                  mData.push_back(row);
-                }
-
-                cell.clear();
-                row.clear();
-                quoted = false;
-              }
-            }
-          }
-          else
-          {
-            cell += buffer[i];
-          }
-        }
-        p_FileLength -= readLength;
+        T val;
+        converter.ToVal(cell, val);
+        row.push_back(val);
       }
+      return row;
+    }
 
-      // Handle last row / cell without linebreak
-      if (row.empty() && cell.empty())
+  private:
+    void BuildIndex()
+    {
+      // row offsets are recorded at row boundaries as found by the tokenizer, so quoted
+      // linebreaks, comments and empty lines are handled as when loading
+      mFile.clear();
+      mFile.seekg(0, std::ios::beg);
+      ResetTokenizer(0);
+      if (Fill() && (mEnd >= 3) && std::equal(s_Utf8BOM.begin(), s_Utf8BOM.end(), mBuffer.data()))
       {
-        // skip empty trailing line
+        // skip UTF-8 Byte order mark
+        mPos = 3;
       }
-      else
-      {
-        row.push_back(Unquote(Trim(cell)));
 
-        if (mLineReaderParams.mSkipCommentLines && !row.at(0).empty() &&
-            (row.at(0)[0] == mLineReaderParams.mCommentPrefix))
+      mOffsets.clear();
+      mNextRowIdx = 0;
+      while (true)
+      {
+        const uint64_t offset = mBufferOffset + mPos;
+        const size_t rowIdx = mNextRowIdx;
+        if (!ReadRow(mCells))
         {
-          // skip comment line
+          break;
         }
-        else
+
+        if ((rowIdx % mRowInterval) == 0)
         {
-          mData.push_back(row);
+          mOffsets.push_back(offset);
         }
-
-        cell.clear();
-        row.clear();
-        quoted = false;
       }
+      mRowCount = mNextRowIdx;
+    }
 
-      // Assume CR/LF if at least half the linebreaks have CR
-      mSeparatorParams.mHasCR = (cr > (lf / 2));
-
-      // Set up column labels
-      UpdateColumnNames();
+    void Seek(const size_t pOffsetIdx)
+    {
+      mFile.clear();
+      mFile.seekg(static_cast<std::streamoff>(mOffsets[pOffsetIdx]), std::ios::beg);
+      ResetTokenizer(mOffsets[pOffsetIdx]);
+      mNextRowIdx = pOffsetIdx * mRowInterval;
+    }
 
-      // Set up row labels
-      UpdateRowNames();
+    void ResetTokenizer(const uint64_t pOffset)
+    {
+      mTokenizer = detail::Tokenizer(mSeparatorParams, mLineReaderParams);
+      mBufferOffset = pOffset;
+      mPos = 0;
+      mEnd = 0;
+      mFinished = false;
     }
 
-    void WriteCsv() const
+    bool ReadRow(std::vector<std::string>& pRow)
     {
-#ifdef HAS_CODECVT
-      if (mIsUtf16)
+      detail::RowBuilder builder(pRow);
+      bool rowRead = false;
+      while (!mFinished && !rowRead)
       {
-        std::stringstream ss;
-        WriteCsv(ss);
-        std::string utf8 = ss.str();
-        std::wstring wstr = ToWString(utf8);
-
-        std::wofstream wstream;
-        wstream.exceptions(std::wofstream::failbit | std::wofstream::badbit);
-        wstream.open(mPath, std::ios::binary | std::ios::trunc);
-
-        if (mIsLE)
+        if (mPos < mEnd)
         {
-          wstream.imbue(std::locale(wstream.getloc(),
-                                    new std::codecvt_utf16<wchar_t, 0x10ffff,
-                                                           static_cast<std::codecvt_mode>(std::little_endian)>));
+          mPos += mTokenizer.Parse(mBuffer.data() + mPos, mEnd - mPos, builder, true /* pStopAtRowEnd */);
+          rowRead = builder.IsRowDone();
         }
-        else
+        else if (!Fill())
         {
-          wstream.imbue(std::locale(wstream.getloc(),
-                                    new std::codecvt_utf16<wchar_t, 0x10ffff>));
+          // Handle last row / cell without linebreak
+          mFinished = true;
+          rowRead = mTokenizer.Finish(builder);
         }
-
-        wstream << static_cast<wchar_t>(0xfeff);
-        wstream << wstr;
       }
-      else
-#endif
+
+      if (!rowRead)
       {
-        std::ofstream stream;
-        stream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
-        stream.open(mPath, std::ios::binary | std::ios::trunc);
-        if (mHasUtf8BOM)
+        if (mRowCount > 0)
         {
-          stream.write(s_Utf8BOM.data(), 3);
+          // the file was modified after it was indexed
+          throw std::out_of_range("row out of range: " + std::to_string(mNextRowIdx));
         }
 
-        WriteCsv(stream);
+        return false;
       }
-    }
-
-    void WriteCsv(std::ostream& pStream) const
-    {
-      for (auto itr = mData.begin(); itr != mData.end(); ++itr)
-      {
-        for (auto itc = itr->begin(); itc != itr->end(); ++itc)
-        {
-          if (mSeparatorParams.mAutoQuote &&
-              ((itc->find(mSeparatorParams.mSeparator) != std::string::npos) ||
-               (itc->find(' ') != std::string::npos) ||
-               (itc->find('\n') != std::string::npos)))
-          {
-            // escape quotes in string
-            std::string str = *itc;
-            const std::string quoteCharStr = std::string(1, mSeparatorParams.mQuoteChar);
-            ReplaceString(str, quoteCharStr, quoteCharStr + quoteCharStr);
-
-            pStream << quoteCharStr << str << quoteCharStr;
-          }
-          else
-          {
-            pStream << *itc;
-          }
 
-          if (std::distance(itc, itr->end()) > 1)
-          {
-            pStream << mSeparatorParams.mSeparator;
-          }
-        }
-        pStream << (mSeparatorParams.mHasCR ? "\r\n" : "\n");
-      }
+      ++mNextRowIdx;
+      return true;
     }
 
-    size_t GetDataRowCount() const
+    bool Fill()
     {
-      return mData.size();
+      mBufferOffset += mEnd;
+      mFile.read(mBuffer.data(), static_cast<std::streamsize>(mBuffer.size()));
+      const std::streamsize readLength = mFile.gcount();
+      mPos = 0;
+      mEnd = (readLength > 0) ? static_cast<size_t>(readLength) : 0;
+      return mEnd > 0;
     }
 
-    size_t GetDataColumnCount() const
+    std::string GetIndexPath() const
     {
-      const size_t firstDataRow =
-        static_cast<size_t>((mLabelParams.mColumnNameIdx >= 0) ? mLabelParams.mColumnNameIdx : 0);
-      return (mData.size() > firstDataRow) ? mData.at(firstDataRow).size() : 0;
+      return mPath + ".idx";
     }
 
-    inline size_t GetDataRowIndex(const size_t pRowIdx) const
+    std::string GetIndexHeader(const int64_t pSize, const int64_t pTime) const
     {
-      const size_t firstDataRow =
-        static_cast<size_t>((mLabelParams.mColumnNameIdx + 1 >= 0) ? mLabelParams.mColumnNameIdx + 1 : 0);
-      return pRowIdx + firstDataRow;
+      // the index is only valid for the same file data and the same parameters
+      std::ostringstream header;
+      header << "rapidcsv-index 2 " << pSize << " " << pTime << " " << mRowInterval << " "
+             << static_cast<int>(mSeparatorParams.mSeparator) << " " << mSeparatorParams.mTrim << " "
+             << mSeparatorParams.mHasCR << " " << mSeparatorParams.mQuotedLinebreaks << " "
+             << mSeparatorParams.mAutoQuote << " " << static_cast<int>(mSeparatorParams.mQuoteChar) << " "
+             << mLineReaderParams.mSkipCommentLines << " "
+             << static_cast<int>(mLineReaderParams.mCommentPrefix) << " "
+             << mLineReaderParams.mSkipEmptyLines;
+      return header.str();
     }
 
-    inline size_t GetDataColumnIndex(const size_t pColumnIdx) const
+    bool ReadIndex(const int64_t pSize, const int64_t pTime)
     {
-      const size_t firstDataColumn =
-        static_cast<size_t>((mLabelParams.mRowNameIdx + 1 >= 0) ? mLabelParams.mRowNameIdx + 1 : 0);
-      return pColumnIdx + firstDataColumn;
-    }
+      std::ifstream file(GetIndexPath(), std::ios::binary);
+      std::string header;
+      if (!std::getline(file, header) || (header != GetIndexHeader(pSize, pTime)))
+      {
+        return false;
+      }
 
-    std::string Trim(const std::string& pStr) const
-    {
-      if (mSeparatorParams.mTrim)
+      size_t rowCount = 0;
+      size_t offsetCount = 0;
+      if (!(file >> rowCount >> offsetCount) || (offsetCount != ((rowCount + mRowInterval - 1) / mRowInterval)))
+      {
+        return false;
+      }
+
+      std::vector<uint64_t> offsets(offsetCount);
+      for (auto& offset : offsets)
       {
-        std::string str = pStr;
+        if (!(file >> offset) || (offset > static_cast<uint64_t>(pSize)))
+        {
+          return false;
+        }
+      }
 
-        // ltrim
-        str.erase(str.begin(), std::find_if(str.begin(), str.end(), [](unsigned char ch) { return !isspace(ch); }));
+      mRowCount = rowCount;
+      mNextRowIdx = rowCount;
+      mOffsets.swap(offsets);
+      return true;
+    }
 
-        // rtrim
-        str.erase(std::find_if(str.rbegin(), str.rend(), [](unsigned char ch) { return !isspace(ch); }).base(), str.end());
+    void WriteIndex(const int64_t pSize, const int64_t pTime) const
+    {
+      // the index file is written atomically, and failure to write it is not an error, as the
+      // CSV-file is then simply scanned again next time
+      const std::string indexPath = GetIndexPath();
+      const std::string tempPath = detail::GetTempPath(indexPath);
+      try
+      {
+        std::ofstream file;
+        file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+        file.open(tempPath, std::ios::binary | std::ios::trunc);
+        file << GetIndexHeader(pSize, pTime) << "\n" << mRowCount << " " << mOffsets.size() << "\n";
+        for (const uint64_t offset : mOffsets)
+        {
+          file << offset << "\n";
+        }
+        file.close();
 
-        return str;
+        detail::ReplaceFile(tempPath, indexPath);
       }
-      else
+      catch (const std::exception&)
       {
-        return pStr;
+        std::remove(tempPath.c_str());
       }
     }
 
-    std::string Unquote(const std::string& pStr) const
+  private:
+    static const size_t sBufferLength = 64 * 1024;
+    std::string mPath;
+    SeparatorParams mSeparatorParams;
+    ConverterParams mConverterParams;
+    detail::NumericLocale mNumericLocale;
+    LineReaderParams mLineReaderParams;
+    size_t mRowInterval;
+    std::ifstream mFile;
+    detail::Tokenizer mTokenizer;
+    std::vector<char> mBuffer;
+    uint64_t mBufferOffset;
+    size_t mPos;
+    size_t mEnd;
+    bool mFinished;
+    size_t mNextRowIdx;
+    size_t mRowCount;
+    std::vector<uint64_t> mOffsets;
+    std::vector<std::string> mCells;
+  };
+
+  /**
+   * @brief     Class for writing CSV data one row at a time, without storing the document.
+   *            Cells are formatted and quoted as when saving a Document, into a buffer which
+   *            is written to the file or stream in large blocks. UTF-16 output is not supported.
+   */
+  class Writer
+  {
+  public:
+    /**
+     * @brief   Constructor
+     * @param   pPath                 specifies the path of the CSV-file to write. An existing
+     *                                file is overwritten.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how numbers should be converted.
+     */
+    explicit Writer(const std::string& pPath,
+                    const SeparatorParams& pSeparatorParams = SeparatorParams(),
+                    const ConverterParams& pConverterParams = ConverterParams())
+      : mFile()
+      , mStream(mFile)
+      , mConverterParams(pConverterParams)
+      , mNumericLocale()
+      , mFormatter(pSeparatorParams)
+      , mBuffer()
+      , mCell()
+      , mColumnIdx(0)
     {
-      if (mSeparatorParams.mAutoQuote && (pStr.size() >= 2) &&
-          (pStr.front() == mSeparatorParams.mQuoteChar) &&
-          (pStr.back() == mSeparatorParams.mQuoteChar))
-      {
-        // remove start/end quotes
-        std::string str = pStr.substr(1, pStr.size() - 2);
+      mFile.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+      mFile.open(pPath, std::ios::binary | std::ios::trunc);
+      mBuffer.reserve(sBufferLength + (sBufferLength / 4));
+    }
 
-        // unescape quotes in string
-        const std::string quoteCharStr = std::string(1, mSeparatorParams.mQuoteChar);
-        ReplaceString(str, quoteCharStr + quoteCharStr, quoteCharStr);
+    /**
+     * @brief   Constructor
+     * @param   pStream               specifies a binary output stream to write CSV data to.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how numbers should be converted.
+     */
+    explicit Writer(std::ostream& pStream,
+                    const SeparatorParams& pSeparatorParams = SeparatorParams(),
+                    const ConverterParams& pConverterParams = ConverterParams())
+      : mFile()
+      , mStream(pStream)
+      , mConverterParams(pConverterParams)
+      , mNumericLocale()
+      , mFormatter(pSeparatorParams)
+      , mBuffer()
+      , mCell()
+      , mColumnIdx(0)
+    {
+      mBuffer.reserve(sBufferLength + (sBufferLength / 4));
+    }
 
-        return str;
+    /**
+     * @brief   Destructor, writing any buffered data. Errors are ignored, so Flush() should be
+     *          called first when they need to be handled.
+     */
+    ~Writer()
+    {
+      try
+      {
+        Flush();
       }
-      else
+      catch (...)
       {
-        return pStr;
       }
     }
 
-    void UpdateColumnNames()
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    /**
+     * @brief   Write a row.
+     * @param   pRow                  vector of row data.
+     */
+    template<typename T>
+    void WriteRow(const std::vector<T>& pRow)
     {
-      mColumnNames.clear();
-      if ((mLabelParams.mColumnNameIdx >= 0) &&
-          (static_cast<int>(mData.size()) > mLabelParams.mColumnNameIdx))
+      for (const auto& cell : pRow)
       {
-        size_t i = 0;
-        for (auto& columnName : mData[static_cast<size_t>(mLabelParams.mColumnNameIdx)])
-        {
-          mColumnNames[columnName] = i++;
-        }
+        WriteCell(cell);
       }
+      EndRow();
     }
 
-    void UpdateRowNames()
+    /**
+     * @brief   Write a row with one cell per argument. Arguments may be of different types.
+     * @param   pCells                row data.
+     */
+    template<typename... TCells>
+    void WriteRow(const TCells&... pCells)
     {
-      mRowNames.clear();
-      if ((mLabelParams.mRowNameIdx >= 0) &&
-          (static_cast<int>(mData.size()) >
-           (mLabelParams.mColumnNameIdx + 1)))
-      {
-        size_t i = 0;
-        for (auto& dataRow : mData)
-        {
-          if (static_cast<int>(dataRow.size()) > mLabelParams.mRowNameIdx)
-          {
-            mRowNames[dataRow[static_cast<size_t>(mLabelParams.mRowNameIdx)]] = i++;
-          }
-        }
-      }
+      WriteCells(pCells...);
+      EndRow();
     }
 
-#ifdef HAS_CODECVT
-#if defined(_MSC_VER)
-#pragma warning (push)
-#pragma warning (disable: 4996)
-#endif
-    static std::string ToString(const std::wstring& pWStr)
+    /**
+     * @brief   Write buffered data to the file or stream, and flush it.
+     */
+    void Flush()
     {
-      return std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t>{ }.to_bytes(pWStr);
+      mStream.write(mBuffer.data(), static_cast<std::streamsize>(mBuffer.size()));
+      mBuffer.clear();
+      mStream.flush();
     }
 
-    static std::wstring ToWString(const std::string& pStr)
+  private:
+    void WriteCells()
     {
-      return std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t>{ }.from_bytes(pStr);
     }
-#if defined(_MSC_VER)
-#pragma warning (pop)
-#endif
-#endif
 
-    static void ReplaceString(std::string& pStr, const std::string& pSearch, const std::string& pReplace)
+    template<typename TCell, typename... TCells>
+    void WriteCells(const TCell& pCell, const TCells&... pCells)
+    {
+      WriteCell(pCell);
+      WriteCells(pCells...);
+    }
+
+    template<typename T>
+    void WriteCell(const T& pCell)
+    {
+      Converter<T> converter(mConverterParams, mNumericLocale);
+      converter.ToStr(pCell, mCell);
+      WriteCell(mCell.data(), mCell.size());
+    }
+
+    void WriteCell(const std::string& pCell)
+    {
+      WriteCell(pCell.data(), pCell.size());
+    }
+
+    void WriteCell(const char* pCell)
+    {
+      WriteCell(pCell, std::strlen(pCell));
+    }
+
+    void WriteCell(const char* pData, const size_t pLength)
     {
-      size_t pos = 0;
+      if (mColumnIdx++ > 0)
+      {
+        mFormatter.AppendSeparator(mBuffer);
+      }
+      mFormatter.AppendCell(pData, pLength, mBuffer);
+    }
 
-      while ((pos = pStr.find(pSearch, pos)) != std::string::npos)
+    void EndRow()
+    {
+      mFormatter.AppendLineEnd(mBuffer);
+      mColumnIdx = 0;
+      if (mBuffer.size() >= sBufferLength)
       {
-        pStr.replace(pos, pSearch.size(), pReplace);
-        pos += pReplace.size();
+        mStream.write(mBuffer.data(), static_cast<std::streamsize>(mBuffer.size()));
+        mBuffer.clear();
       }
     }
 
   private:
-    std::string mPath;
-    LabelParams mLabelParams;
-    SeparatorParams mSeparatorParams;
+    static const size_t sBufferLength = 64 * 1024;
+    std::ofstream mFile;
+    std::ostream& mStream;
     ConverterParams mConverterParams;
-    LineReaderParams mLineReaderParams;
-    std::vector<std::vector<std::string>> mData;
-    std::map<std::string, size_t> mColumnNames;
-    std::map<std::string, size_t> mRowNames;
-#ifdef HAS_CODECVT
-    bool mIsUtf16 = false;
-    bool mIsLE = false;
-#endif
-    bool mHasUtf8BOM = false;
+    detail::NumericLocale mNumericLocale;
+    detail::CellFormatter mFormatter;
+    std::string mBuffer;
+    std::string mCell;
+    size_t mColumnIdx;
   };
 }
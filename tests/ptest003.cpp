@@ -0,0 +1,45 @@
+// ptest003.cpp - numeric column conversion
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  try
+  {
+    std::string csv = "int,double\n";
+    for (int i = 0; i < 200000; ++i)
+    {
+      csv += std::to_string(i * 7919) + "," + std::to_string(i * 0.37) + "\n";
+    }
+
+    std::istringstream sstream(csv);
+    rapidcsv::Document doc(sstream);
+
+    perftest::Timer timer;
+
+    for (int i = 0; i < 10; ++i)
+    {
+      timer.Start();
+
+      const std::vector<int> ints = doc.GetColumn<int>("int");
+      const std::vector<double> doubles = doc.GetColumn<double>("double");
+
+      timer.Stop();
+
+      unittest::ExpectEqual(size_t, ints.size(), doubles.size());
+    }
+
+    timer.ReportMedian();
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
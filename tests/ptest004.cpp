@@ -0,0 +1,60 @@
+// ptest004.cpp - cell access by name and by handle
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  try
+  {
+    std::string csv = "a,b,c,d\n";
+    for (int i = 0; i < 200000; ++i)
+    {
+      csv += std::to_string(i) + ",1,2," + std::to_string(i % 1000) + "\n";
+    }
+
+    std::istringstream sstream(csv);
+    rapidcsv::Document doc(sstream);
+    const size_t rowCount = doc.GetRowCount();
+
+    perftest::Timer timerName;
+    perftest::Timer timerHandle;
+
+    for (int i = 0; i < 10; ++i)
+    {
+      long long sumName = 0;
+      timerName.Start();
+      for (size_t rowIdx = 0; rowIdx < rowCount; ++rowIdx)
+      {
+        sumName += doc.GetCell<int>("d", rowIdx);
+      }
+      timerName.Stop();
+
+      long long sumHandle = 0;
+      timerHandle.Start();
+      const rapidcsv::ColumnHandle<int> column = doc.GetColumnHandle<int>("d");
+      for (size_t rowIdx = 0; rowIdx < rowCount; ++rowIdx)
+      {
+        sumHandle += doc.GetCell(column, rowIdx);
+      }
+      timerHandle.Stop();
+
+      unittest::ExpectEqual(long long, sumName, sumHandle);
+    }
+
+    std::cout << "by name:   ";
+    timerName.ReportMedian();
+    std::cout << "by handle: ";
+    timerHandle.ReportMedian();
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
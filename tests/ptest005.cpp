@@ -0,0 +1,46 @@
+// ptest005.cpp - batch row removal
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  try
+  {
+    std::string csv = "a,b,c,d\n";
+    for (int i = 0; i < 100000; ++i)
+    {
+      csv += std::to_string(i) + ",1,2,3\n";
+    }
+
+    std::istringstream sstream(csv);
+    const rapidcsv::Document source(sstream);
+
+    perftest::Timer timer;
+
+    for (int i = 0; i < 10; ++i)
+    {
+      rapidcsv::Document doc = source;
+
+      timer.Start();
+
+      doc.RemoveRowsIf([](const size_t pRowIdx) { return (pRowIdx % 10) == 0; });
+
+      timer.Stop();
+
+      unittest::ExpectEqual(size_t, doc.GetRowCount(), 90000);
+    }
+
+    timer.ReportMedian();
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
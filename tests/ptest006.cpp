@@ -0,0 +1,47 @@
+// ptest006.cpp - document save
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  try
+  {
+    std::string csv = "id,name,value,comment\n";
+    for (int i = 0; i < 200000; ++i)
+    {
+      csv += std::to_string(i) + ",name" + std::to_string(i % 100) + "," + std::to_string(i * 0.25) +
+             ",\"some text, " + std::to_string(i) + "\"\n";
+    }
+
+    std::istringstream sstream(csv);
+    rapidcsv::Document doc(sstream, rapidcsv::LabelParams(), rapidcsv::SeparatorParams(',', false, false));
+
+    perftest::Timer timer;
+
+    for (int i = 0; i < 10; ++i)
+    {
+      std::ostringstream ostream;
+
+      timer.Start();
+
+      doc.Save(ostream);
+
+      timer.Stop();
+
+      unittest::ExpectEqual(size_t, ostream.str().size(), csv.size());
+    }
+
+    timer.ReportMedian();
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
@@ -0,0 +1,53 @@
+// ptest008.cpp - indexed random row access
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string path = unittest::TempPath();
+
+  try
+  {
+    std::string csv = "id,name,value,comment\n";
+    for (int i = 0; i < 1000000; ++i)
+    {
+      csv += std::to_string(i) + ",name" + std::to_string(i % 100) + "," + std::to_string(i * 0.25) +
+             ",\"some text, " + std::to_string(i) + "\"\n";
+    }
+    unittest::WriteFile(path, csv);
+
+    rapidcsv::IndexedReader reader(path, rapidcsv::SeparatorParams(',', false, false));
+    std::vector<std::string> row;
+
+    perftest::Timer timer;
+
+    for (int i = 0; i < 5; ++i)
+    {
+      timer.Start();
+
+      for (size_t j = 0; j < 1000; ++j)
+      {
+        const size_t rowIdx = 1 + ((j * 7919 + static_cast<size_t>(i)) % 1000000);
+        reader.GetRow(rowIdx, row);
+        unittest::ExpectEqual(std::string, row.at(0), std::to_string(rowIdx - 1));
+      }
+
+      timer.Stop();
+    }
+
+    timer.ReportMedian();
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
@@ -0,0 +1,47 @@
+// ptest009.cpp - row count without loading
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string path = unittest::TempPath();
+
+  try
+  {
+    std::string csv = "id,name,value,comment\n";
+    for (int i = 0; i < 1000000; ++i)
+    {
+      csv += std::to_string(i) + ",name" + std::to_string(i % 100) + "," + std::to_string(i * 0.25) +
+             ",\"some text, " + std::to_string(i) + "\"\n";
+    }
+    unittest::WriteFile(path, csv);
+
+    perftest::Timer timer;
+
+    for (int i = 0; i < 5; ++i)
+    {
+      timer.Start();
+
+      const size_t rowCount = rapidcsv::Reader::CountRows(path);
+
+      timer.Stop();
+
+      unittest::ExpectEqual(size_t, rowCount, 1000001);
+    }
+
+    timer.ReportMedian();
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
@@ -0,0 +1,62 @@
+// ptest011.cpp - cell access by index
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  try
+  {
+    std::string csv = "a,b,c,d\n";
+    for (int i = 0; i < 200000; ++i)
+    {
+      csv += std::to_string(i) + ",1,2,0.5\n";
+    }
+
+    std::istringstream sstream(csv);
+    rapidcsv::Document doc(sstream);
+    const size_t rowCount = doc.GetRowCount();
+
+    perftest::Timer timerSet;
+    perftest::Timer timerGet;
+
+    for (int i = 0; i < 10; ++i)
+    {
+      timerSet.Start();
+      for (size_t rowIdx = 0; rowIdx < rowCount; ++rowIdx)
+      {
+        doc.SetCell<int>(1, rowIdx, static_cast<int>(rowIdx % 1000));
+        doc.SetCell<double>(3, rowIdx, 0.25 * static_cast<double>(rowIdx % 8));
+      }
+      timerSet.Stop();
+
+      long long sumInt = 0;
+      double sumDouble = 0;
+      timerGet.Start();
+      for (size_t rowIdx = 0; rowIdx < rowCount; ++rowIdx)
+      {
+        sumInt += doc.GetCell<int>(1, rowIdx);
+        sumDouble += doc.GetCell<double>(3, rowIdx);
+      }
+      timerGet.Stop();
+
+      unittest::ExpectEqual(long long, sumInt, 99900000);
+      unittest::ExpectEqual(double, sumDouble, 175000.0);
+    }
+
+    std::cout << "set: ";
+    timerSet.ReportMedian();
+    std::cout << "get: ";
+    timerGet.ReportMedian();
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
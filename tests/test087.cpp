@@ -55,6 +55,29 @@ int main()
       unittest::ExpectEqual(float, doc.GetCell<float>("B", "2"), 0.01f);
       unittest::ExpectEqual(float, doc.GetCell<float>("C", "2"), 0.001f);
     }
+
+    {
+      std::string csv =
+        "-;A\n"
+        "1;0.5\n"
+        "2;0,5\n"
+      ;
+
+      unittest::WriteFile(path, csv);
+
+      // the decimal point is detected when loading, so a later locale change only applies
+      // to plain numbers after loading again
+      std::setlocale(LC_ALL, "C");
+      rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0),
+                             rapidcsv::SeparatorParams(';' /* pSeparator */));
+      std::setlocale(LC_ALL, loc.c_str());
+      unittest::ExpectEqual(float, doc.GetCell<float>("A", "1"), 0.5f);
+      unittest::ExpectEqual(float, doc.GetCell<float>("A", "2"), 0.5f);
+
+      doc.Load(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(';' /* pSeparator */));
+      unittest::ExpectEqual(float, doc.GetCell<float>("A", "1"), 0.0f);
+      unittest::ExpectEqual(float, doc.GetCell<float>("A", "2"), 0.5f);
+    }
   }
   catch (const std::exception& ex)
   {
@@ -60,6 +60,22 @@ int main()
       unittest::ExpectEqual(float, doc.GetCell<float>("B", "2"), 0.01f);
       unittest::ExpectEqual(float, doc.GetCell<float>("C", "2"), 0.001f);
     }
+
+    {
+      // the global locale is detected when loading, so numbers set after a later locale
+      // change are formatted as for the previous locale until loading again
+      std::locale::global(std::locale::classic());
+      std::istringstream sstream("A\n1\n");
+      rapidcsv::Document doc(sstream, rapidcsv::LabelParams(0, -1));
+      std::locale::global(std::locale(loc.c_str()));
+      doc.SetCell<double>(0, 0, 0.5);
+      unittest::ExpectEqual(std::string, doc.GetCell<std::string>(0, 0), "0.5");
+
+      std::istringstream sstream2("A\n1\n");
+      doc.Load(sstream2, rapidcsv::LabelParams(0, -1));
+      doc.SetCell<double>(0, 0, 0.5);
+      unittest::ExpectEqual(std::string, doc.GetCell<std::string>(0, 0), "0,5");
+    }
   }
   catch (const std::exception& ex)
   {
@@ -14,7 +14,7 @@ int main()
     "unsigned,65535\n"
     "unsigned long,4294967295\n"
     "unsigned long long,18446744073709551615\n"
-    "float,3.40282347e+38\n"
+    "float,3.4028235e+38\n"
     "double,1.6e+308\n"
     "long double,1.6e+308\n"
     "signed char,-128\n"
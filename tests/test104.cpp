@@ -0,0 +1,246 @@
+// test104.cpp - structural character scanning with all supported instruction sets
+
+#include <random>
+#include <rapidcsv.h>
+#include "unittest.h"
+
+static std::vector<std::vector<std::string>> ReadAll(const std::string& pCsv,
+                                                     const rapidcsv::SeparatorParams& pSeparatorParams,
+                                                     const rapidcsv::LineReaderParams& pLineReaderParams)
+{
+  std::istringstream sstream(pCsv);
+  rapidcsv::Document doc(sstream, rapidcsv::LabelParams(-1, -1), pSeparatorParams,
+                         rapidcsv::ConverterParams(), pLineReaderParams);
+  std::vector<std::vector<std::string>> rows;
+  for (size_t i = 0; i < doc.GetRowCount(); ++i)
+  {
+    rows.push_back(doc.GetRow<std::string>(i));
+  }
+  return rows;
+}
+
+// reference implementation of the byte-by-byte parser loop
+static std::vector<std::vector<std::string>> RefParse(const std::string& pCsv,
+                                                      const rapidcsv::SeparatorParams& pSeparatorParams,
+                                                      const rapidcsv::LineReaderParams& pLineReaderParams)
+{
+  std::vector<std::vector<std::string>> rows;
+  std::vector<std::string> row;
+  std::string cell;
+  bool quoted = false;
+  const char quoteChar = pSeparatorParams.mQuoteChar;
+
+  auto trimUnquote = [&](const std::string& pStr)
+  {
+    std::string str = pStr;
+    if (pSeparatorParams.mTrim)
+    {
+      str.erase(str.begin(), std::find_if(str.begin(), str.end(), [](unsigned char ch) { return !isspace(ch); }));
+      str.erase(std::find_if(str.rbegin(), str.rend(), [](unsigned char ch) { return !isspace(ch); }).base(),
+                str.end());
+    }
+
+    if (pSeparatorParams.mAutoQuote && (str.size() >= 2) && (str.front() == quoteChar) && (str.back() == quoteChar))
+    {
+      const std::string inner = str.substr(1, str.size() - 2);
+      str.clear();
+      for (size_t i = 0; i < inner.size(); ++i)
+      {
+        str += inner[i];
+        if ((inner[i] == quoteChar) && ((i + 1) < inner.size()) && (inner[i + 1] == quoteChar))
+        {
+          ++i;
+        }
+      }
+    }
+    return str;
+  };
+
+  auto endRow = [&]()
+  {
+    row.push_back(trimUnquote(cell));
+    if (!(pLineReaderParams.mSkipCommentLines && !row.at(0).empty() &&
+          (row.at(0)[0] == pLineReaderParams.mCommentPrefix)))
+    {
+      rows.push_back(row);
+    }
+    cell.clear();
+    row.clear();
+    quoted = false;
+  };
+
+  for (const char ch : pCsv)
+  {
+    if (ch == quoteChar)
+    {
+      if (cell.empty() || (cell[0] == quoteChar))
+      {
+        quoted = !quoted;
+      }
+      else if (pSeparatorParams.mTrim)
+      {
+        const auto firstQuote = std::find(cell.begin(), cell.end(), quoteChar);
+        if (std::all_of(cell.begin(), firstQuote, [](unsigned char c) { return isspace(c); }))
+        {
+          quoted = !quoted;
+        }
+      }
+      cell += ch;
+    }
+    else if (ch == pSeparatorParams.mSeparator)
+    {
+      if (!quoted)
+      {
+        row.push_back(trimUnquote(cell));
+        cell.clear();
+      }
+      else
+      {
+        cell += ch;
+      }
+    }
+    else if ((ch == '\r') || (ch == '\n'))
+    {
+      if (pSeparatorParams.mQuotedLinebreaks && quoted)
+      {
+        cell += ch;
+      }
+      else if ((ch == '\n') && !(pLineReaderParams.mSkipEmptyLines && row.empty() && cell.empty()))
+      {
+        endRow();
+      }
+    }
+    else
+    {
+      cell += ch;
+    }
+  }
+
+  if (!row.empty() || !cell.empty())
+  {
+    endRow();
+  }
+
+  return rows;
+}
+
+int main()
+{
+  int rv = 0;
+
+  try
+  {
+    const rapidcsv::detail::SimdLevel supported = rapidcsv::detail::GetSupportedSimdLevel();
+
+    // compare block masks of each instruction set against the scalar implementation
+    std::mt19937 rng(104);
+    const std::string alphabet = "ab ,;\"'\r\n#x";
+    std::uniform_int_distribution<size_t> charDist(0, alphabet.size() - 1);
+    for (int n = 0; n < 1000; ++n)
+    {
+      char block[64];
+      for (size_t i = 0; i < sizeof(block); ++i)
+      {
+        block[i] = alphabet[charDist(rng)];
+      }
+
+      const char chars[4] = { '"', ',', '\r', '\n' };
+      const uint64_t ref = rapidcsv::detail::BlockMaskScalar(block, chars);
+      for (int level = rapidcsv::detail::SimdSse2; level <= supported; ++level)
+      {
+        const rapidcsv::detail::BlockMaskFunc func =
+          rapidcsv::detail::GetBlockMaskFunc(static_cast<rapidcsv::detail::SimdLevel>(level));
+        unittest::ExpectEqual(uint64_t, func(block, chars), ref);
+      }
+    }
+
+    // generate csv data with cells of varying length, quoting and line endings, spanning
+    // several read buffers
+    std::string csv;
+    std::uniform_int_distribution<int> lenDist(0, 150);
+    std::uniform_int_distribution<int> kindDist(0, 9);
+    while (csv.size() < (200 * 1024))
+    {
+      const int cols = 1 + (kindDist(rng) % 5);
+      for (int c = 0; c < cols; ++c)
+      {
+        std::string cell;
+        const int len = lenDist(rng);
+        for (int i = 0; i < len; ++i)
+        {
+          cell += static_cast<char>('a' + (i % 26));
+        }
+
+        const int kind = kindDist(rng);
+        if (kind == 0)
+        {
+          csv += "\"" + cell + ",\"\"" + cell + "\"\"\r\n" + cell + "\"";
+        }
+        else if (kind == 1)
+        {
+          csv += "  \"" + cell + "\"  ";
+        }
+        else if (kind == 2)
+        {
+          csv += "#" + cell;
+        }
+        else if (kind == 3)
+        {
+          csv += "x" + cell + "\"" + cell;
+        }
+        else
+        {
+          csv += cell;
+        }
+
+        if ((c + 1) < cols)
+        {
+          csv += ",";
+        }
+      }
+
+      const int eol = kindDist(rng);
+      csv += (eol == 0) ? "\r\n" : ((eol == 1) ? "\n\n" : "\n");
+    }
+
+    const std::vector<rapidcsv::SeparatorParams> separatorParamsList =
+    {
+      rapidcsv::SeparatorParams(),
+      rapidcsv::SeparatorParams(',', true /* pTrim */),
+      rapidcsv::SeparatorParams(',', false, false, true /* pQuotedLinebreaks */),
+      rapidcsv::SeparatorParams(',', true /* pTrim */, false, true /* pQuotedLinebreaks */, false /* pAutoQuote */),
+    };
+
+    const std::vector<rapidcsv::LineReaderParams> lineReaderParamsList =
+    {
+      rapidcsv::LineReaderParams(),
+      rapidcsv::LineReaderParams(true /* pSkipCommentLines */, '#', true /* pSkipEmptyLines */),
+    };
+
+    for (const auto& separatorParams : separatorParamsList)
+    {
+      for (const auto& lineReaderParams : lineReaderParamsList)
+      {
+        const std::vector<std::vector<std::string>> ref = RefParse(csv, separatorParams, lineReaderParams);
+        unittest::ExpectTrue(ref.size() > 500);
+
+        for (int level = rapidcsv::detail::SimdScalar; level <= supported; ++level)
+        {
+          rapidcsv::detail::SetSimdLevel(static_cast<rapidcsv::detail::SimdLevel>(level));
+          const std::vector<std::vector<std::string>> rows = ReadAll(csv, separatorParams, lineReaderParams);
+          unittest::ExpectEqual(size_t, rows.size(), ref.size());
+          unittest::ExpectTrue(rows == ref);
+        }
+      }
+    }
+
+    rapidcsv::detail::SetSimdLevel(supported);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
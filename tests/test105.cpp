@@ -0,0 +1,121 @@
+// test105.cpp - load file using memory mapping
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+#ifndef _MSC_VER
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "\xef\xbb\xbf-,A,B,C\r\n"
+    "1,3,9,81\r\n"
+    "2,4,16,\"25,6\"\r\n"
+  ;
+
+  std::string path = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  std::string emptyPath = unittest::TempPath();
+  unittest::WriteFile(emptyPath, "");
+
+  std::string outPath = unittest::TempPath();
+
+  try
+  {
+    const rapidcsv::LoadParams loadParams(true /* pMemoryMap */);
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                           rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), loadParams);
+    unittest::ExpectEqual(size_t, doc.GetRowCount(), 2);
+    unittest::ExpectEqual(size_t, doc.GetColumnCount(), 3);
+    unittest::ExpectEqual(int, doc.GetCell<int>("A", "2"), 4);
+    unittest::ExpectEqual(int, doc.GetCell<int>("C", "1"), 81);
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>("C", "2"), "25,6");
+
+    // BOM and line endings are preserved as with stream loading
+    doc.Save(outPath);
+    unittest::ExpectEqual(std::string, unittest::ReadFile(outPath), csv);
+
+    // reload using Load()
+    rapidcsv::Document doc2;
+    doc2.Load(path, rapidcsv::LabelParams(-1, -1), rapidcsv::SeparatorParams(),
+              rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), loadParams);
+    unittest::ExpectEqual(size_t, doc2.GetRowCount(), 3);
+    unittest::ExpectEqual(std::string, doc2.GetCell<std::string>(0, 0), "-");
+
+    // empty file
+    rapidcsv::Document doc3(emptyPath, rapidcsv::LabelParams(), rapidcsv::SeparatorParams(),
+                            rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), loadParams);
+    unittest::ExpectEqual(size_t, doc3.GetRowCount(), 0);
+    unittest::ExpectEqual(size_t, doc3.GetColumnCount(), 0);
+
+    // non-existing file
+    ExpectException(rapidcsv::Document(path + "-nonexisting", rapidcsv::LabelParams(), rapidcsv::SeparatorParams(),
+                                       rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), loadParams),
+                    std::ios_base::failure);
+
+#ifndef _MSC_VER
+    // pipe, which cannot be mapped, is read as a stream
+    std::string fifoPath = unittest::TempPath();
+    unittest::DeleteFile(fifoPath);
+    if (mkfifo(fifoPath.c_str(), 0600) == 0)
+    {
+      std::thread writer([&]()
+      {
+        std::ofstream fifo(fifoPath, std::ios::binary);
+        fifo << csv;
+      });
+
+      rapidcsv::Document fifoDoc;
+      try
+      {
+        fifoDoc.Load(fifoPath, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                     rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), loadParams);
+      }
+      catch (...)
+      {
+        // open the pipe for reading, so the writer is not left blocked waiting for a reader
+        const int fd = open(fifoPath.c_str(), O_RDONLY | O_NONBLOCK);
+        writer.join();
+        if (fd >= 0)
+        {
+          close(fd);
+        }
+        unittest::DeleteFile(fifoPath);
+        throw;
+      }
+      writer.join();
+      unittest::DeleteFile(fifoPath);
+
+      rapidcsv::Document streamDoc(path, rapidcsv::LabelParams(0, 0));
+      unittest::ExpectEqual(size_t, fifoDoc.GetRowCount(), streamDoc.GetRowCount());
+      unittest::ExpectEqual(size_t, fifoDoc.GetColumnCount(), streamDoc.GetColumnCount());
+      unittest::ExpectEqual(std::string, fifoDoc.GetCell<std::string>("C", "2"), "25,6");
+
+      std::string streamOutPath = unittest::TempPath();
+      streamDoc.Save(streamOutPath);
+      fifoDoc.Save(outPath);
+      const std::string streamOut = unittest::ReadFile(streamOutPath);
+      unittest::DeleteFile(streamOutPath);
+      unittest::ExpectEqual(std::string, unittest::ReadFile(outPath), streamOut);
+    }
+#endif
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+  unittest::DeleteFile(emptyPath);
+  unittest::DeleteFile(outPath);
+
+  return rv;
+}
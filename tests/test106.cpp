@@ -0,0 +1,124 @@
+// test106.cpp - parallel parsing
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+/**
+ * @brief   Stream buffer which does not support seeking, like a pipe.
+ */
+class UnseekableBuffer : public std::streambuf
+{
+public:
+  explicit UnseekableBuffer(std::string& pData)
+  {
+    setg(&pData[0], &pData[0], &pData[0] + pData.size());
+  }
+};
+
+static void CheckParallel(const std::string& pCsv, const rapidcsv::SeparatorParams& pSeparatorParams,
+                          const rapidcsv::LineReaderParams& pLineReaderParams)
+{
+  const std::string path = unittest::TempPath();
+  unittest::WriteFile(path, pCsv);
+
+  rapidcsv::Document refDoc(path, rapidcsv::LabelParams(-1, -1), pSeparatorParams,
+                            rapidcsv::ConverterParams(), pLineReaderParams);
+  unittest::ExpectTrue(refDoc.GetRowCount() > 1000);
+
+  for (const unsigned threads : { 0u, 4u })
+  {
+    // from file, read into memory
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(-1, -1), pSeparatorParams,
+                           rapidcsv::ConverterParams(), pLineReaderParams,
+                           rapidcsv::LoadParams(false, threads));
+    unittest::ExpectSameDocument(doc, refDoc);
+
+    // from memory mapped file
+    rapidcsv::Document mappedDoc(path, rapidcsv::LabelParams(-1, -1), pSeparatorParams,
+                                 rapidcsv::ConverterParams(), pLineReaderParams,
+                                 rapidcsv::LoadParams(true, threads));
+    unittest::ExpectSameDocument(mappedDoc, refDoc);
+
+    // from stream
+    std::istringstream sstream(pCsv);
+    rapidcsv::Document streamDoc(sstream, rapidcsv::LabelParams(-1, -1), pSeparatorParams,
+                                 rapidcsv::ConverterParams(), pLineReaderParams,
+                                 rapidcsv::LoadParams(false, threads));
+    unittest::ExpectSameDocument(streamDoc, refDoc);
+  }
+
+  unittest::DeleteFile(path);
+}
+
+int main()
+{
+  int rv = 0;
+
+  try
+  {
+    // well-formed data with quoted linebreaks, comments and empty lines
+    std::string csv;
+    for (int i = 0; csv.size() < (800 * 1024); ++i)
+    {
+      csv += std::to_string(i) + ",abc def,\"quoted, \"\"text\"\"\"";
+      if ((i % 7) == 0)
+      {
+        csv += ",\"multi\r\nline\ncell\"";
+      }
+      csv += ((i % 2) == 0) ? "\r\n" : "\n";
+
+      if ((i % 11) == 0)
+      {
+        csv += "# comment line with \"quote\n";
+      }
+
+      if ((i % 13) == 0)
+      {
+        csv += "\n";
+      }
+    }
+
+    const rapidcsv::LineReaderParams skipParams(true /* pSkipCommentLines */, '#', true /* pSkipEmptyLines */);
+    const rapidcsv::SeparatorParams quotedLinebreaks(',', false, rapidcsv::sPlatformHasCR,
+                                                     true /* pQuotedLinebreaks */);
+    CheckParallel(csv, rapidcsv::SeparatorParams(), rapidcsv::LineReaderParams());
+    CheckParallel(csv, rapidcsv::SeparatorParams(), skipParams);
+    CheckParallel(csv, quotedLinebreaks, rapidcsv::LineReaderParams());
+    CheckParallel(csv, quotedLinebreaks, skipParams);
+
+    // quote characters inside unquoted cells invalidate quote parity based splitting, which
+    // must be detected and handled by falling back to sequential parsing
+    std::string oddCsv = "id,size\n1,5\" pipe\n";
+    for (int i = 0; oddCsv.size() < (800 * 1024); ++i)
+    {
+      oddCsv += std::to_string(i) + ",\"a\nb\nc\nd\ne\nf\ng\nh\",x\n";
+    }
+
+    CheckParallel(oddCsv, quotedLinebreaks, rapidcsv::LineReaderParams());
+    CheckParallel(oddCsv, quotedLinebreaks, skipParams);
+
+    // last row without linebreak
+    CheckParallel(csv + "last,row", quotedLinebreaks, skipParams);
+
+    // stream of unknown length is parsed as with one thread
+    std::vector<size_t> rowCounts;
+    for (const unsigned threads : { 1u, 4u })
+    {
+      std::string data = "A,B\n1,2\n";
+      UnseekableBuffer buffer(data);
+      std::istream stream(&buffer);
+      rapidcsv::Document doc(stream, rapidcsv::LabelParams(), rapidcsv::SeparatorParams(),
+                             rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                             rapidcsv::LoadParams(false, threads));
+      rowCounts.push_back(doc.GetRowCount());
+    }
+    unittest::ExpectEqual(size_t, rowCounts.at(0), rowCounts.at(1));
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
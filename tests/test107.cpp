@@ -0,0 +1,125 @@
+// test107.cpp - arena storage
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+static void ExpectSameCells(rapidcsv::Document& pDoc, rapidcsv::Document& pRefDoc)
+{
+  for (size_t i = 0; i < pRefDoc.GetColumnCount(); ++i)
+  {
+    unittest::ExpectTrue(pDoc.GetColumn<std::string>(i) == pRefDoc.GetColumn<std::string>(i));
+  }
+}
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B,C\n"
+    "1,3,9,81\n"
+    "2,4,16,\"25,6\"\n"
+    "3,\"\",\" x \",\n"
+  ;
+
+  std::string path = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    const rapidcsv::LoadParams arenaParams(false, 1, true /* pArenaStorage */);
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                           rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), arenaParams);
+    rapidcsv::Document refDoc(path, rapidcsv::LabelParams(0, 0));
+    unittest::ExpectSameDocument(doc, refDoc);
+
+    // cells are read from the arena
+    ExpectSameCells(doc, refDoc);
+
+    unittest::ExpectEqual(int, doc.GetCell<int>("A", "2"), 4);
+    unittest::ExpectEqual(int, doc.GetCell<int>(2, 0), 81);
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>("C", "2"), "25,6");
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>("B", "3"), " x ");
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>("C", "3"), "");
+    unittest::ExpectEqual(std::string, doc.GetColumnName(1), "B");
+    unittest::ExpectEqual(std::string, doc.GetRowName(2), "3");
+    unittest::ExpectEqual(int, doc.GetRow<int>("2").at(1), 16);
+    unittest::ExpectEqual(int, doc.GetCell<int>(0, 0, [](const std::string& pStr, int& pVal)
+    {
+      pVal = 2 * std::stoi(pStr);
+    }), 6);
+    ExpectException(doc.GetCell<int>(3, 0), std::out_of_range);
+    ExpectException(doc.GetCell<int>(0, 3), std::out_of_range);
+    ExpectException(doc.GetRow<int>(3), std::out_of_range);
+
+    // first modification copies all cells from the arena to regular storage
+    doc.SetCell<int>("A", "3", 5);
+    refDoc.SetCell<int>("A", "3", 5);
+    unittest::ExpectEqual(int, doc.GetCell<int>("A", "3"), 5);
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>("C", "2"), "25,6");
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>("B", "3"), " x ");
+    ExpectSameCells(doc, refDoc);
+    unittest::ExpectSameDocument(doc, refDoc);
+    doc.InsertRow<int>(0, std::vector<int>({ 7, 8, 9 }), "0");
+    refDoc.InsertRow<int>(0, std::vector<int>({ 7, 8, 9 }), "0");
+    unittest::ExpectSameDocument(doc, refDoc);
+    unittest::ExpectEqual(int, doc.GetCell<int>("C", "0"), 9);
+
+    // each kind of modification copies the cells before changing them
+    const std::vector<std::function<void(rapidcsv::Document&)>> modifications =
+    {
+      [](rapidcsv::Document& pDoc) { pDoc.SetColumnName(1, "X"); },
+      [](rapidcsv::Document& pDoc) { pDoc.SetRowName(1, "X"); },
+      [](rapidcsv::Document& pDoc) { pDoc.SetRow<int>(1, std::vector<int>({ 1, 2, 3 })); },
+      [](rapidcsv::Document& pDoc) { pDoc.SetColumn<int>(2, std::vector<int>({ 1, 2, 3 })); },
+      [](rapidcsv::Document& pDoc) { pDoc.RemoveRow(0); },
+      [](rapidcsv::Document& pDoc) { pDoc.RemoveColumn(0); },
+      [](rapidcsv::Document& pDoc) { pDoc.InsertColumn<int>(1, std::vector<int>({ 1, 2, 3 }), "X"); },
+    };
+    for (const auto& modify : modifications)
+    {
+      rapidcsv::Document modDoc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                                rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), arenaParams);
+      rapidcsv::Document modRefDoc(path, rapidcsv::LabelParams(0, 0));
+      modify(modDoc);
+      modify(modRefDoc);
+      ExpectSameCells(modDoc, modRefDoc);
+      unittest::ExpectSameDocument(modDoc, modRefDoc);
+    }
+
+    // reload into existing document
+    doc.Load(path, rapidcsv::LabelParams(-1, -1), rapidcsv::SeparatorParams(),
+             rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), arenaParams);
+    rapidcsv::Document refDoc2(path, rapidcsv::LabelParams(-1, -1));
+    unittest::ExpectSameDocument(doc, refDoc2);
+    doc.Clear();
+    unittest::ExpectEqual(size_t, doc.GetRowCount(), 0);
+
+    // large data parsed in parallel chunks
+    std::string bigCsv = "id,text,value\n";
+    for (int i = 0; bigCsv.size() < (600 * 1024); ++i)
+    {
+      bigCsv += std::to_string(i) + ",\"quoted, \"\"text\"\"\"," + std::to_string(i * 3) + "\n";
+    }
+    unittest::WriteFile(path, bigCsv);
+
+    for (const unsigned threads : { 1u, 4u })
+    {
+      rapidcsv::Document bigDoc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                                rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                rapidcsv::LoadParams(false, threads, true /* pArenaStorage */));
+      rapidcsv::Document bigRefDoc(path, rapidcsv::LabelParams(0, 0));
+      unittest::ExpectSameDocument(bigDoc, bigRefDoc);
+      unittest::ExpectEqual(int, bigDoc.GetCell<int>("value", "1000"), 3000);
+    }
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
@@ -0,0 +1,88 @@
+// test108.cpp - read rows using streaming reader
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "\xef\xbb\xbf" "A,B,C\n"
+    "# comment\n"
+    "3,9,81\r\n"
+    "\n"
+    "4,16,\"2\n56\"\n"
+    "5,25"
+  ;
+
+  std::string path = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    const rapidcsv::SeparatorParams separatorParams(',', false, rapidcsv::sPlatformHasCR,
+                                                    true /* pQuotedLinebreaks */);
+    const rapidcsv::LineReaderParams lineReaderParams(true /* pSkipCommentLines */, '#',
+                                                      true /* pSkipEmptyLines */);
+    rapidcsv::Reader reader(path, separatorParams, rapidcsv::ConverterParams(), lineReaderParams);
+    std::vector<std::string> row;
+    unittest::ExpectTrue(reader.Next(row));
+    unittest::ExpectTrue(row == std::vector<std::string>({ "A", "B", "C" }));
+    unittest::ExpectTrue(reader.Next(row));
+    unittest::ExpectTrue(row == std::vector<std::string>({ "3", "9", "81" }));
+    unittest::ExpectTrue(reader.Next(row));
+    unittest::ExpectTrue(row == std::vector<std::string>({ "4", "16", "2\n56" }));
+    std::vector<int> intRow;
+    unittest::ExpectTrue(reader.Next(intRow));
+    unittest::ExpectTrue(intRow == std::vector<int>({ 5, 25 }));
+    unittest::ExpectTrue(!reader.Next(row));
+    unittest::ExpectTrue(!reader.Next(row));
+
+    // conversion errors are reported as for Document
+    std::istringstream sstream("1,x\n");
+    rapidcsv::Reader streamReader(sstream);
+    ExpectException(streamReader.Next(intRow), std::invalid_argument);
+
+    // rows spanning read buffers match Document contents
+    std::string bigCsv;
+    for (int i = 0; bigCsv.size() < (300 * 1024); ++i)
+    {
+      bigCsv += std::to_string(i) + ",\"quoted\n" + std::string(static_cast<size_t>(i % 500), 'x') + "\"\r\n";
+      if ((i % 17) == 0)
+      {
+        bigCsv += "\n# comment\n";
+      }
+    }
+
+    std::istringstream bigStream(bigCsv);
+    rapidcsv::Document doc(bigStream, rapidcsv::LabelParams(-1, -1), separatorParams,
+                           rapidcsv::ConverterParams(), lineReaderParams);
+    std::istringstream bigStream2(bigCsv);
+    rapidcsv::Reader bigReader(bigStream2, separatorParams, rapidcsv::ConverterParams(), lineReaderParams);
+    size_t rowCount = 0;
+    while (bigReader.Next(row))
+    {
+      unittest::ExpectTrue(row == doc.GetRow<std::string>(rowCount));
+      ++rowCount;
+    }
+    unittest::ExpectEqual(size_t, rowCount, doc.GetRowCount());
+
+    // empty data
+    std::istringstream emptyStream("");
+    rapidcsv::Reader emptyReader(emptyStream);
+    unittest::ExpectTrue(!emptyReader.Next(row));
+
+    // non-existing file
+    ExpectException(rapidcsv::Reader(path + "-nonexisting"), std::ios_base::failure);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
@@ -0,0 +1,109 @@
+// test109.cpp - push parsing with handler callbacks
+
+#include <numeric>
+#include <rapidcsv.h>
+#include "unittest.h"
+
+class SumHandler
+{
+public:
+  SumHandler()
+    : mSum(0)
+    , mRows(0)
+    , mColumnIdx(0)
+    , mCells()
+  {
+  }
+
+  void OnCell(const char* pData, const size_t pLength)
+  {
+    if (mColumnIdx == 1)
+    {
+      mSum += std::stoi(std::string(pData, pLength));
+    }
+    mCells += "[" + std::string(pData, pLength) + "]";
+    ++mColumnIdx;
+  }
+
+  void OnRowEnd()
+  {
+    mCells += "\n";
+    mColumnIdx = 0;
+    ++mRows;
+  }
+
+  int mSum;
+  int mRows;
+  size_t mColumnIdx;
+  std::string mCells;
+};
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "\xef\xbb\xbf" "A,1,x\n"
+    "# comment,1\n"
+    "\n"
+    "  B , 2 ,\"y \"\"z\"\"\"\r\n"
+    "C,\"3\",\"multi\nline\""
+  ;
+
+  std::string path = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    const rapidcsv::SeparatorParams separatorParams(',', true /* pTrim */, rapidcsv::sPlatformHasCR,
+                                                    true /* pQuotedLinebreaks */);
+    const rapidcsv::LineReaderParams lineReaderParams(true /* pSkipCommentLines */, '#',
+                                                      true /* pSkipEmptyLines */);
+    const rapidcsv::Parser parser(separatorParams, lineReaderParams);
+    const std::string expCells = "[A][1][x]\n[B][2][y \"z\"]\n[C][3][multi\nline]\n";
+
+    SumHandler fileHandler;
+    parser.Parse(path, fileHandler);
+    unittest::ExpectEqual(int, fileHandler.mSum, 6);
+    unittest::ExpectEqual(int, fileHandler.mRows, 3);
+    unittest::ExpectEqual(std::string, fileHandler.mCells, expCells);
+
+    std::istringstream sstream(csv);
+    SumHandler streamHandler;
+    parser.Parse(sstream, streamHandler);
+    unittest::ExpectEqual(std::string, streamHandler.mCells, expCells);
+
+    SumHandler memHandler;
+    parser.Parse(csv.data(), csv.size(), memHandler);
+    unittest::ExpectEqual(std::string, memHandler.mCells, expCells);
+
+    // results match Document for data spanning several read buffers
+    std::string bigCsv;
+    for (int i = 0; bigCsv.size() < (200 * 1024); ++i)
+    {
+      bigCsv += "r" + std::to_string(i) + "," + std::to_string(i % 10) + ",\"a,b\nc\"\n";
+    }
+
+    std::istringstream bigStream(bigCsv);
+    SumHandler bigHandler;
+    parser.Parse(bigStream, bigHandler);
+    std::istringstream bigStream2(bigCsv);
+    rapidcsv::Document doc(bigStream2, rapidcsv::LabelParams(-1, -1), separatorParams,
+                           rapidcsv::ConverterParams(), lineReaderParams);
+    const std::vector<int> column = doc.GetColumn<int>(1);
+    unittest::ExpectEqual(int, bigHandler.mRows, static_cast<int>(doc.GetRowCount()));
+    unittest::ExpectEqual(int, bigHandler.mSum, std::accumulate(column.begin(), column.end(), 0));
+
+    // non-existing file
+    ExpectException(parser.Parse(path + "-nonexisting", fileHandler), std::ios_base::failure);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
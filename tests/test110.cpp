@@ -0,0 +1,124 @@
+// test110.cpp - load selected columns only
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B,C,D\n"
+    "1,3,9,81,x\n"
+    "2,4,16,256,y\n"
+  ;
+
+  std::string path = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    // select by index
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                           rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                           rapidcsv::LoadParams(false, 1, false, { 3, 1 }));
+    unittest::ExpectEqual(size_t, doc.GetColumnCount(), 2);
+    unittest::ExpectEqual(size_t, doc.GetRowCount(), 2);
+    unittest::ExpectTrue(doc.GetColumnNames() == std::vector<std::string>({ "B", "D" }));
+    unittest::ExpectEqual(int, doc.GetCell<int>(0, 1), 16);
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>("D", "2"), "y");
+    unittest::ExpectTrue(doc.GetRow<std::string>("1") == std::vector<std::string>({ "9", "x" }));
+    ExpectException(doc.GetColumn<int>("A"), std::out_of_range);
+
+    // select by name, combined with index, using arena storage
+    rapidcsv::Document doc2(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                            rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                            rapidcsv::LoadParams(false, 1, true, { 0 }, { "C" }));
+    unittest::ExpectTrue(doc2.GetColumnNames() == std::vector<std::string>({ "A", "C" }));
+    unittest::ExpectTrue(doc2.GetColumn<int>("C") == std::vector<int>({ 81, 256 }));
+    std::ostringstream out;
+    doc2.Save(out);
+    unittest::ExpectEqual(std::string, out.str(), "-,A,C\n1,3,81\n2,4,256\n");
+
+    // no labels, from stream
+    std::istringstream sstream(csv);
+    rapidcsv::Document doc3(sstream, rapidcsv::LabelParams(-1, -1), rapidcsv::SeparatorParams(),
+                            rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                            rapidcsv::LoadParams(false, 1, false, { 4, 0 }));
+    unittest::ExpectEqual(size_t, doc3.GetColumnCount(), 2);
+    unittest::ExpectTrue(doc3.GetRow<std::string>(2) == std::vector<std::string>({ "2", "y" }));
+
+    // column label row after first row
+    std::istringstream sstream2("info,,,,\n" + csv);
+    rapidcsv::Document doc4(sstream2, rapidcsv::LabelParams(1, 0), rapidcsv::SeparatorParams(),
+                            rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                            rapidcsv::LoadParams(false, 1, false, {}, { "D" }));
+    unittest::ExpectTrue(doc4.GetColumnNames() == std::vector<std::string>({ "D" }));
+    unittest::ExpectEqual(std::string, doc4.GetCell<std::string>("D", "1"), "x");
+
+    // missing column names
+    ExpectExceptionMsg(rapidcsv::Document(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                                          rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                          rapidcsv::LoadParams(false, 1, false, {}, { "E" })),
+                       std::out_of_range, "column not found: E");
+    ExpectException(rapidcsv::Document(path, rapidcsv::LabelParams(-1, -1), rapidcsv::SeparatorParams(),
+                                       rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                       rapidcsv::LoadParams(false, 1, false, {}, { "A" })),
+                    std::out_of_range);
+
+    // column indices past the last column
+    ExpectExceptionMsg(rapidcsv::Document(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                                          rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                          rapidcsv::LoadParams(false, 1, false, { 1, 4 })),
+                       std::out_of_range, "column index out of range: 4");
+    ExpectExceptionMsg(rapidcsv::Document(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                                          rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                          rapidcsv::LoadParams(false, 1, false, { 7 }, { "A" })),
+                       std::out_of_range, "column index out of range: 7");
+    std::istringstream sstream3(csv);
+    ExpectExceptionMsg(rapidcsv::Document(sstream3, rapidcsv::LabelParams(-1, -1), rapidcsv::SeparatorParams(),
+                                          rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                          rapidcsv::LoadParams(false, 1, false, { 5 })),
+                       std::out_of_range, "column index out of range: 5");
+
+    // large data parsed in parallel
+    std::string bigCsv = "id,a,b,c\n";
+    for (int i = 0; bigCsv.size() < (600 * 1024); ++i)
+    {
+      bigCsv += std::to_string(i) + ",\"x,y\"," + std::to_string(i * 2) + ",z\n";
+    }
+    unittest::WriteFile(path, bigCsv);
+
+    for (const bool arena : { false, true })
+    {
+      rapidcsv::Document bigDoc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                                rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                rapidcsv::LoadParams(false, 4, arena, {}, { "b" }));
+      rapidcsv::Document bigRefDoc(path, rapidcsv::LabelParams(0, 0));
+      unittest::ExpectEqual(size_t, bigDoc.GetColumnCount(), 1);
+      unittest::ExpectEqual(size_t, bigDoc.GetRowCount(), bigRefDoc.GetRowCount());
+      unittest::ExpectTrue(bigDoc.GetColumn<int>("b") == bigRefDoc.GetColumn<int>("b"));
+      unittest::ExpectTrue(bigDoc.GetRowNames() == bigRefDoc.GetRowNames());
+
+      rapidcsv::Document bigIdxDoc(path, rapidcsv::LabelParams(-1, -1), rapidcsv::SeparatorParams(),
+                                   rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                   rapidcsv::LoadParams(false, 4, arena, { 2 }));
+      unittest::ExpectEqual(size_t, bigIdxDoc.GetColumnCount(), 1);
+      unittest::ExpectEqual(size_t, bigIdxDoc.GetRowCount(), bigRefDoc.GetRowCount() + 1);
+      unittest::ExpectEqual(std::string, bigIdxDoc.GetCell<std::string>(0, 0), "b");
+      ExpectExceptionMsg(rapidcsv::Document(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                                            rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                            rapidcsv::LoadParams(false, 4, arena, { 3 })),
+                         std::out_of_range, "column index out of range: 3");
+    }
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
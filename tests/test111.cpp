@@ -0,0 +1,90 @@
+// test111.cpp - filter rows at load time
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B,C\n"
+    "1,3,9,81\n"
+    "2,4,16,256\n"
+    "3,5,25,625\n"
+  ;
+
+  std::string path = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    // keep rows with even values in column A, label row is not filtered
+    const rapidcsv::RowFilterFunc evenA = [](const std::vector<std::string>& pRow)
+    {
+      return (std::stoi(pRow.at(1)) % 2) == 0;
+    };
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                           rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                           rapidcsv::LoadParams(false, 1, false, {}, {}, evenA));
+    unittest::ExpectEqual(size_t, doc.GetRowCount(), 1);
+    unittest::ExpectTrue(doc.GetRowNames() == std::vector<std::string>({ "2" }));
+    unittest::ExpectEqual(int, doc.GetCell<int>("C", "2"), 256);
+    unittest::ExpectEqual(int, doc.GetRowIdx("1"), -1);
+
+    // filter sees selected columns only, with arena storage and no labels
+    std::vector<size_t> rowSizes;
+    const rapidcsv::RowFilterFunc notC81 = [&](const std::vector<std::string>& pRow)
+    {
+      rowSizes.push_back(pRow.size());
+      return pRow.at(1) != "81";
+    };
+    rapidcsv::Document doc2(path, rapidcsv::LabelParams(-1, -1), rapidcsv::SeparatorParams(),
+                            rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                            rapidcsv::LoadParams(false, 1, true, { 0, 3 }, {}, notC81));
+    unittest::ExpectTrue(rowSizes == std::vector<size_t>({ 2, 2, 2, 2 }));
+    unittest::ExpectEqual(size_t, doc2.GetRowCount(), 3);
+    unittest::ExpectTrue(doc2.GetColumn<std::string>(0) == std::vector<std::string>({ "-", "2", "3" }));
+
+    // reject all rows
+    std::istringstream sstream(csv);
+    rapidcsv::Document doc3(sstream, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                            rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                            rapidcsv::LoadParams(false, 1, false, {}, {},
+                                                 [](const std::vector<std::string>&) { return false; }));
+    unittest::ExpectEqual(size_t, doc3.GetRowCount(), 0);
+    unittest::ExpectTrue(doc3.GetColumnNames() == std::vector<std::string>({ "A", "B", "C" }));
+
+    // large data parsed in parallel
+    std::string bigCsv = "id,value\n";
+    for (int i = 0; bigCsv.size() < (600 * 1024); ++i)
+    {
+      bigCsv += std::to_string(i) + "," + std::to_string(i % 10) + "\n";
+    }
+    unittest::WriteFile(path, bigCsv);
+
+    const rapidcsv::RowFilterFunc value3 = [](const std::vector<std::string>& pRow)
+    {
+      return pRow.at(1) == "3";
+    };
+    rapidcsv::Document bigDoc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                              rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                              rapidcsv::LoadParams(false, 4, false, {}, {}, value3));
+    rapidcsv::Document bigRefDoc(path, rapidcsv::LabelParams(0, 0));
+    const std::vector<int> refValues = bigRefDoc.GetColumn<int>("value");
+    unittest::ExpectEqual(size_t, bigDoc.GetRowCount(),
+                          static_cast<size_t>(std::count(refValues.begin(), refValues.end(), 3)));
+    unittest::ExpectEqual(std::string, bigDoc.GetRowName(0), "3");
+    unittest::ExpectEqual(std::string, bigDoc.GetRowName(bigDoc.GetRowCount() - 1),
+                          std::to_string(((bigRefDoc.GetRowCount() - 4) / 10) * 10 + 3));
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
@@ -0,0 +1,182 @@
+// test112.cpp - numeric conversion fast path
+
+#include <random>
+#include <rapidcsv.h>
+#include "unittest.h"
+
+template<typename T>
+static T ToVal(const std::string& pStr, const rapidcsv::ConverterParams& pConverterParams = rapidcsv::ConverterParams())
+{
+  T val;
+  rapidcsv::Converter<T> converter(pConverterParams);
+  converter.ToVal(pStr, val);
+  return val;
+}
+
+// reference conversion using the standard library, as done before the fast path was added
+template<typename T>
+static T RefToVal(const std::string& pStr, const bool pNumericLocale)
+{
+  if (pNumericLocale)
+  {
+    return (sizeof(T) == sizeof(float)) ? static_cast<T>(std::stof(pStr)) : static_cast<T>(std::stod(pStr));
+  }
+
+  T val;
+  std::istringstream iss(pStr);
+  iss.imbue(std::locale::classic());
+  iss >> val;
+  if (iss.fail() || iss.bad() || !iss.eof())
+  {
+    throw std::invalid_argument("istringstream: no conversion");
+  }
+  return val;
+}
+
+template<typename T>
+static void ExpectSameAsRef(const std::string& pStr, const bool pNumericLocale)
+{
+  T ref = 0;
+  bool refThrows = false;
+  try
+  {
+    ref = RefToVal<T>(pStr, pNumericLocale);
+  }
+  catch (const std::exception&)
+  {
+    refThrows = true;
+  }
+
+  T val = 0;
+  bool valThrows = false;
+  try
+  {
+    val = ToVal<T>(pStr, rapidcsv::ConverterParams(false, 0, 0, pNumericLocale));
+  }
+  catch (const std::exception&)
+  {
+    valThrows = true;
+  }
+
+  if ((valThrows != refThrows) || (std::memcmp(&val, &ref, sizeof(T)) != 0))
+  {
+    throw std::runtime_error("conversion mismatch for \"" + pStr + "\"");
+  }
+}
+
+int main()
+{
+  int rv = 0;
+
+  try
+  {
+    // integers
+    unittest::ExpectEqual(int, ToVal<int>("0"), 0);
+    unittest::ExpectEqual(int, ToVal<int>("+17"), 17);
+    unittest::ExpectEqual(int, ToVal<int>("-007"), -7);
+    unittest::ExpectEqual(int, ToVal<int>("2147483647"), 2147483647);
+    unittest::ExpectEqual(int, ToVal<int>("-2147483648"), std::numeric_limits<int>::min());
+    unittest::ExpectEqual(long long, ToVal<long long>("-9223372036854775808"), std::numeric_limits<long long>::min());
+    unittest::ExpectEqual(unsigned long long, ToVal<unsigned long long>("18446744073709551615"),
+                          std::numeric_limits<unsigned long long>::max());
+    unittest::ExpectEqual(int, ToVal<short>("40000"), static_cast<short>(40000));
+    unittest::ExpectEqual(unsigned, ToVal<unsigned>("-1"), static_cast<unsigned>(std::stoul("-1")));
+    ExpectException(ToVal<int>("2147483648"), std::out_of_range);
+    ExpectException(ToVal<long long>("9223372036854775808"), std::out_of_range);
+    ExpectException(ToVal<int>(""), std::invalid_argument);
+    ExpectException(ToVal<int>("x"), std::invalid_argument);
+
+    // input outside the plain format is converted as before
+    unittest::ExpectEqual(int, ToVal<int>(" 12"), 12);
+    unittest::ExpectEqual(int, ToVal<int>("12abc"), 12);
+    unittest::ExpectEqual(double, ToVal<double>(" 1.5"), 1.5);
+
+    // defaults
+    const rapidcsv::ConverterParams defaultParams(true /* pHasDefaultConverter */, 0.5, -1);
+    unittest::ExpectEqual(int, ToVal<int>("", defaultParams), -1);
+    unittest::ExpectEqual(int, ToVal<int>("x", defaultParams), -1);
+    unittest::ExpectEqual(double, ToVal<double>("", defaultParams), 0.5);
+    unittest::ExpectEqual(float, ToVal<float>("", defaultParams), 0.5f);
+    unittest::ExpectEqual(double, ToVal<double>("1e999", defaultParams), 0.5);
+    ExpectException(ToVal<double>("1e999"), std::out_of_range);
+
+    // non-numeric cells are replaced by defaults, while other formats are converted as before
+    for (const bool numericLocale : { true, false })
+    {
+      const rapidcsv::ConverterParams params(true /* pHasDefaultConverter */, 0.5, -1, numericLocale);
+      for (const std::string str : { "N/A", "abc", "-", "+", " ", "--1", "." })
+      {
+        unittest::ExpectEqual(int, ToVal<int>(str, params), -1);
+        unittest::ExpectEqual(long long, ToVal<long long>(str, params), -1);
+        unittest::ExpectEqual(unsigned long, ToVal<unsigned long>(str, params), static_cast<unsigned long>(-1));
+        unittest::ExpectEqual(short, ToVal<short>(str, params), -1);
+        unittest::ExpectEqual(double, ToVal<double>(str, params), 0.5);
+        unittest::ExpectEqual(float, ToVal<float>(str, params), 0.5f);
+        unittest::ExpectEqual(long double, ToVal<long double>(str, params), 0.5L);
+      }
+
+      unittest::ExpectEqual(int, ToVal<int>(" 12", params), 12);
+      unittest::ExpectEqual(int, ToVal<int>("12abc", params), 12);
+      unittest::ExpectEqual(int, ToVal<int>("2147483648", params), -1);
+      unittest::ExpectEqual(long long, ToVal<long long>("-99999999999999999999", params), -1);
+      unittest::ExpectEqual(unsigned long long, ToVal<unsigned long long>("0x10", params), 0);
+      unittest::ExpectEqual(double, ToVal<double>("1e999", params), 0.5);
+      unittest::ExpectEqual(long double, ToVal<long double>("2.5", params), 2.5L);
+    }
+
+    std::istringstream sstream("A,B\n1,N/A\nx,2.5\n,-\n");
+    rapidcsv::Document doc(sstream, rapidcsv::LabelParams(), rapidcsv::SeparatorParams(), defaultParams);
+    unittest::ExpectTrue(doc.GetColumn<int>("A") == std::vector<int>({ 1, -1, -1 }));
+    unittest::ExpectTrue(doc.GetColumn<double>("B") == std::vector<double>({ 0.5, 2.5, 0.5 }));
+
+    // floating point, with and without numeric locale
+    for (const bool numericLocale : { true, false })
+    {
+      const rapidcsv::ConverterParams params(false, 0, 0, numericLocale);
+      unittest::ExpectEqual(double, ToVal<double>("0.1", params), 0.1);
+      unittest::ExpectEqual(double, ToVal<double>("-2.5e-3", params), -2.5e-3);
+      unittest::ExpectEqual(double, ToVal<double>("1E22", params), 1e22);
+      unittest::ExpectEqual(double, ToVal<double>(".5", params), 0.5);
+      unittest::ExpectEqual(double, ToVal<double>("3.", params), 3.0);
+      unittest::ExpectTrue(std::signbit(ToVal<double>("-0", params)));
+      ExpectException(ToVal<double>("", params), std::invalid_argument);
+
+      const std::vector<std::string> strs =
+      {
+        "123456789012345678901234", "0.000000000000000000000000001", "9007199254740993",
+        "2.2250738585072011e-308", "1.7976931348623157e308", "4.9e-324", "0.30000000000000004",
+        "123.456e-7", "00000000000000000000000001.5", "3.4028235e38", "1.17549435e-38", "1e999",
+        "-1e-999", "1e", "1.2.3", "+-1", "inf", "nan", "0x10",
+      };
+      for (const auto& str : strs)
+      {
+        ExpectSameAsRef<double>(str, numericLocale);
+        ExpectSameAsRef<float>(str, numericLocale);
+      }
+
+      // random values compared to the standard library
+      std::mt19937_64 rng(112);
+      std::uniform_int_distribution<int> expDist(-40, 40);
+      std::uniform_int_distribution<int> precDist(1, 19);
+      std::uniform_int_distribution<uint64_t> bitsDist;
+      for (int i = 0; i < 20000; ++i)
+      {
+        const double mag = std::ldexp(static_cast<double>(bitsDist(rng) >> 11), expDist(rng) - 53);
+        const double val = ((i % 2) == 0) ? mag : -mag;
+        char buf[64];
+        const char* const formats[] = { "%.*g", "%.*e", "%.*f" };
+        snprintf(buf, sizeof(buf), formats[i % 3], precDist(rng), val);
+        const std::string str(buf);
+        ExpectSameAsRef<double>(str, numericLocale);
+        ExpectSameAsRef<float>(str, numericLocale);
+      }
+    }
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
@@ -0,0 +1,129 @@
+// test113.cpp - shortest round-trip number formatting
+
+#include <random>
+#include <rapidcsv.h>
+#include "unittest.h"
+
+template<typename T>
+static std::string ToStr(const T& pVal)
+{
+  std::string str;
+  rapidcsv::Converter<T> converter((rapidcsv::ConverterParams()));
+  converter.ToStr(pVal, str);
+  return str;
+}
+
+template<typename T>
+static T ToVal(const std::string& pStr)
+{
+  T val;
+  rapidcsv::Converter<T> converter((rapidcsv::ConverterParams()));
+  converter.ToVal(pStr, val);
+  return val;
+}
+
+int main()
+{
+  int rv = 0;
+
+  try
+  {
+    // integers
+    unittest::ExpectEqual(std::string, ToStr<int>(0), "0");
+    unittest::ExpectEqual(std::string, ToStr<int>(-42), "-42");
+    unittest::ExpectEqual(std::string, ToStr<int>(std::numeric_limits<int>::min()), "-2147483648");
+    unittest::ExpectEqual(std::string, ToStr<long long>(std::numeric_limits<long long>::min()),
+                          "-9223372036854775808");
+    unittest::ExpectEqual(std::string, ToStr<unsigned long long>(std::numeric_limits<unsigned long long>::max()),
+                          "18446744073709551615");
+    unittest::ExpectEqual(std::string, ToStr<short>(-32768), "-32768");
+    unittest::ExpectEqual(std::string, ToStr<unsigned short>(65535), "65535");
+    unittest::ExpectEqual(std::string, ToStr<signed char>(-128), "-128");
+    unittest::ExpectEqual(std::string, ToStr<unsigned char>(255), "255");
+    unittest::ExpectEqual(std::string, ToStr<char>('x'), "x");
+
+    // shortest representation
+    unittest::ExpectEqual(std::string, ToStr<double>(0.1), "0.1");
+    unittest::ExpectEqual(std::string, ToStr<double>(0.1 + 0.2), "0.30000000000000004");
+    unittest::ExpectEqual(std::string, ToStr<double>(-1.5), "-1.5");
+    unittest::ExpectEqual(std::string, ToStr<double>(0.0), "0");
+    unittest::ExpectEqual(std::string, ToStr<double>(-0.0), "-0");
+    unittest::ExpectEqual(std::string, ToStr<double>(100.0), "100");
+    unittest::ExpectEqual(std::string, ToStr<double>(1234.5678), "1234.5678");
+    unittest::ExpectEqual(std::string, ToStr<float>(0.1f), "0.1");
+    unittest::ExpectEqual(std::string, ToStr<float>(3.14159f), "3.14159");
+    unittest::ExpectEqual(std::string, ToStr<float>(16777216.0f), "16777216");
+
+    // notation follows the stream precision thresholds, with at least two exponent digits
+    unittest::ExpectEqual(std::string, ToStr<double>(0.0001), "0.0001");
+    unittest::ExpectEqual(std::string, ToStr<double>(0.00001), "1e-05");
+    unittest::ExpectEqual(std::string, ToStr<double>(1e16), "10000000000000000");
+    unittest::ExpectEqual(std::string, ToStr<double>(1e17), "1e+17");
+    unittest::ExpectEqual(std::string, ToStr<double>(1.6e308), "1.6e+308");
+    unittest::ExpectEqual(std::string, ToStr<double>(2.5e-300), "2.5e-300");
+    unittest::ExpectEqual(std::string, ToStr<double>(5e-324), "5e-324");
+    unittest::ExpectEqual(std::string, ToStr<float>(1e8f), "100000000");
+    unittest::ExpectEqual(std::string, ToStr<float>(1e9f), "1e+09");
+    unittest::ExpectEqual(std::string, ToStr<float>(std::numeric_limits<float>::max()), "3.4028235e+38");
+
+    // non-finite values use the stream formatting
+    unittest::ExpectEqual(std::string, ToStr<double>(std::numeric_limits<double>::infinity()), "inf");
+    unittest::ExpectEqual(std::string, ToStr<double>(-std::numeric_limits<double>::infinity()), "-inf");
+
+    // random values round-trip and are never longer than with the previous stream formatting
+    std::mt19937_64 rng(113);
+    std::uniform_int_distribution<uint64_t> bitsDist;
+    for (int i = 0; i < 20000; ++i)
+    {
+      const uint64_t bits = bitsDist(rng);
+      double dval = 0;
+      std::memcpy(&dval, &bits, sizeof(dval));
+      float fval = 0;
+      const uint32_t fbits = static_cast<uint32_t>(bits >> 32);
+      std::memcpy(&fval, &fbits, sizeof(fval));
+
+      if (std::isfinite(dval))
+      {
+        const std::string str = ToStr<double>(dval);
+        unittest::ExpectTrue(std::strtod(str.c_str(), nullptr) == dval);
+
+        std::ostringstream out;
+        out << std::setprecision(17) << dval;
+        unittest::ExpectTrue(str.size() <= out.str().size());
+      }
+
+      if (std::isfinite(fval))
+      {
+        const std::string str = ToStr<float>(fval);
+        unittest::ExpectTrue(std::strtof(str.c_str(), nullptr) == fval);
+
+        std::ostringstream out;
+        out << std::setprecision(9) << fval;
+        unittest::ExpectTrue(str.size() <= out.str().size());
+      }
+
+      const long long ival = static_cast<long long>(bits);
+      unittest::ExpectEqual(std::string, ToStr<long long>(ival), std::to_string(ival));
+      unittest::ExpectEqual(long long, ToVal<long long>(ToStr<long long>(ival)), ival);
+    }
+
+    // document round-trip
+    std::vector<double> values;
+    for (int i = 0; i < 1000; ++i)
+    {
+      values.push_back(i / 10.0);
+    }
+
+    rapidcsv::Document doc("", rapidcsv::LabelParams(-1, -1));
+    doc.SetColumn<double>(0, values);
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>(0, 3), "0.3");
+    unittest::ExpectTrue(doc.GetColumn<double>(0) == values);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
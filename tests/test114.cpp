@@ -0,0 +1,89 @@
+// test114.cpp - cached column access
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B,C\n"
+    "1,3,9,81\n"
+    "2,4,16,256\n"
+  ;
+
+  std::string path = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0));
+
+    // repeated calls return the same cached data
+    const std::vector<int>& colA = doc.GetColumnCached<int>("A");
+    unittest::ExpectEqual(size_t, colA.size(), 2);
+    unittest::ExpectEqual(int, colA.at(0), 3);
+    unittest::ExpectEqual(int, colA.at(1), 4);
+    unittest::ExpectTrue(&doc.GetColumnCached<int>(0) == &colA);
+
+    // separate cache entry per datatype
+    const std::vector<double>& colADouble = doc.GetColumnCached<double>(0);
+    unittest::ExpectEqual(double, colADouble.at(1), 4.0);
+    unittest::ExpectTrue(&doc.GetColumnCached<int>(0) == &colA);
+
+    // modifying a column only invalidates that column
+    const std::vector<int>& colB = doc.GetColumnCached<int>("B");
+    const std::vector<int>& colC = doc.GetColumnCached<int>("C");
+    doc.SetCell<int>("A", "2", 5);
+    unittest::ExpectEqual(int, doc.GetColumnCached<int>("A").at(1), 5);
+    unittest::ExpectEqual(double, doc.GetColumnCached<double>("A").at(1), 5.0);
+    unittest::ExpectTrue(&doc.GetColumnCached<int>("B") == &colB);
+    unittest::ExpectTrue(&doc.GetColumnCached<int>("C") == &colC);
+
+    doc.SetColumn<int>("B", std::vector<int>({ 10, 20 }));
+    unittest::ExpectEqual(int, doc.GetColumnCached<int>("B").at(1), 20);
+    unittest::ExpectTrue(&doc.GetColumnCached<int>("C") == &colC);
+
+    // removing or inserting a column invalidates it and all following columns
+    const std::vector<int>& colA2 = doc.GetColumnCached<int>(0);
+    doc.RemoveColumn("B");
+    unittest::ExpectTrue(&doc.GetColumnCached<int>(0) == &colA2);
+    unittest::ExpectEqual(int, doc.GetColumnCached<int>(1).at(0), 81);
+    ExpectException(doc.GetColumnCached<int>(2), std::out_of_range);
+
+    doc.InsertColumn<int>(1, std::vector<int>({ 7, 8 }), "D");
+    unittest::ExpectTrue(&doc.GetColumnCached<int>(0) == &colA2);
+    unittest::ExpectEqual(int, doc.GetColumnCached<int>("D").at(1), 8);
+    unittest::ExpectEqual(int, doc.GetColumnCached<int>(2).at(1), 256);
+
+    // setting a cell beyond the last row adds a row to all columns
+    doc.SetCell<int>(1, 2, 9);
+    unittest::ExpectEqual(size_t, doc.GetColumnCached<int>(1).size(), 3);
+    ExpectException(doc.GetColumnCached<int>(0), std::invalid_argument);
+
+    // row modifications invalidate all columns
+    doc.RemoveRow(2);
+    unittest::ExpectEqual(size_t, doc.GetColumnCached<int>(0).size(), 2);
+    doc.InsertRow<int>(0, std::vector<int>({ 1, 2, 3 }), "0");
+    unittest::ExpectEqual(int, doc.GetColumnCached<int>(0).at(0), 1);
+    doc.SetRow<int>(0, std::vector<int>({ 4, 5, 6 }));
+    unittest::ExpectEqual(int, doc.GetColumnCached<int>(2).at(0), 6);
+
+    // reload clears the cache
+    doc.Load(path, rapidcsv::LabelParams(0, 0));
+    unittest::ExpectEqual(int, doc.GetColumnCached<int>("C").at(1), 256);
+    unittest::ExpectEqual(int, doc.GetColumnCached<int>(0).at(1), 4);
+
+    ExpectException(doc.GetColumnCached<int>("X"), std::out_of_range);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
@@ -0,0 +1,96 @@
+// test115.cpp - label hash index
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B,A\n"
+    "x,3,9,81\n"
+    "y,4,16,256\n"
+    "x,5,25,625\n"
+  ;
+
+  std::string path = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    // index with many labels, including empty and binary labels
+    rapidcsv::detail::LabelIndex index;
+    unittest::ExpectEqual(size_t, index.GetSize(), 0);
+    size_t val = 0;
+    unittest::ExpectTrue(!index.Find("a", val));
+
+    const size_t count = 100000;
+    for (size_t i = 0; i < count; ++i)
+    {
+      index.Set("label" + std::to_string(i), i);
+    }
+    index.Set("", 7);
+    index.Set(std::string("a\0b", 3), 8);
+
+    unittest::ExpectEqual(size_t, index.GetSize(), count + 2);
+    for (size_t i = 0; i < count; ++i)
+    {
+      unittest::ExpectTrue(index.Find("label" + std::to_string(i), val));
+      unittest::ExpectEqual(size_t, val, i);
+    }
+    unittest::ExpectTrue(!index.Find("label" + std::to_string(count), val));
+    unittest::ExpectTrue(!index.Find("label", val));
+    unittest::ExpectTrue(index.Find("", val));
+    unittest::ExpectEqual(size_t, val, 7);
+    unittest::ExpectTrue(index.Find("a\0b", 3, val));
+    unittest::ExpectEqual(size_t, val, 8);
+    unittest::ExpectTrue(!index.Find("a", val));
+
+    // last duplicate wins, without adding an entry
+    index.Set("label5", 42);
+    unittest::ExpectEqual(size_t, index.GetSize(), count + 2);
+    unittest::ExpectTrue(index.Find("label5", val));
+    unittest::ExpectEqual(size_t, val, 42);
+
+    // compact memory usage per label
+    unittest::ExpectTrue(index.GetMemoryUsage() < (count * 64));
+
+    index.Clear();
+    unittest::ExpectEqual(size_t, index.GetSize(), 0);
+    unittest::ExpectTrue(!index.Find("label5", val));
+    index.Reserve(1000);
+    index.Set("z", 1);
+    unittest::ExpectTrue(index.Find("z", val));
+    unittest::ExpectEqual(size_t, val, 1);
+
+    // document label lookup with duplicate labels, last one wins
+    for (const bool arenaStorage : { false, true })
+    {
+      rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                             rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                             rapidcsv::LoadParams(false, 1, arenaStorage));
+      unittest::ExpectEqual(int, doc.GetColumnIdx("A"), 2);
+      unittest::ExpectEqual(int, doc.GetColumnIdx("B"), 1);
+      unittest::ExpectEqual(int, doc.GetColumnIdx("C"), -1);
+      unittest::ExpectEqual(int, doc.GetRowIdx("x"), 2);
+      unittest::ExpectEqual(int, doc.GetRowIdx("y"), 1);
+      unittest::ExpectEqual(int, doc.GetRowIdx("z"), -1);
+      unittest::ExpectEqual(int, doc.GetCell<int>("A", "x"), 625);
+      unittest::ExpectEqual(int, doc.GetCell<int>("B", "y"), 16);
+
+      doc.SetColumnName(0, "C");
+      doc.SetRowName(0, "z");
+      unittest::ExpectEqual(int, doc.GetCell<int>("C", "z"), 3);
+    }
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
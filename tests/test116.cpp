@@ -0,0 +1,125 @@
+// test116.cpp - lazy row label index with incremental updates
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B\n"
+    "r0,0,0\n"
+    "r1,1,1\n"
+    "r2,2,4\n"
+    "r3,3,9\n"
+  ;
+
+  std::string path = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    // label index erase and value offsets
+    rapidcsv::detail::LabelIndex index;
+    const size_t count = 10000;
+    for (size_t i = 0; i < count; ++i)
+    {
+      index.Set("label" + std::to_string(i), i);
+    }
+    unittest::ExpectTrue(!index.HasDuplicates());
+
+    size_t val = 0;
+    for (size_t i = 0; i < count; i += 2)
+    {
+      unittest::ExpectTrue(index.Erase("label" + std::to_string(i)));
+    }
+    unittest::ExpectTrue(!index.Erase("label0"));
+    unittest::ExpectEqual(size_t, index.GetSize(), count / 2);
+    for (size_t i = 0; i < count; ++i)
+    {
+      unittest::ExpectEqual(bool, index.Find("label" + std::to_string(i), val), (i % 2) == 1);
+    }
+
+    index.OffsetValues(5000, static_cast<size_t>(-1));
+    unittest::ExpectTrue(index.Find("label4999", val));
+    unittest::ExpectEqual(size_t, val, 4999);
+    unittest::ExpectTrue(index.Find("label5001", val));
+    unittest::ExpectEqual(size_t, val, 5000);
+
+    // erasing most labels compacts the entries
+    for (size_t i = 1; i < count - 1; i += 2)
+    {
+      index.Erase("label" + std::to_string(i));
+    }
+    unittest::ExpectEqual(size_t, index.GetSize(), 1);
+    unittest::ExpectTrue(index.Find("label9999", val));
+    unittest::ExpectEqual(size_t, val, 9998);
+    index.Set("label9999", 1);
+    unittest::ExpectTrue(index.HasDuplicates());
+
+    // document row names after structural edits
+    for (const bool arenaStorage : { false, true })
+    {
+      rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                             rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                             rapidcsv::LoadParams(false, 1, arenaStorage));
+
+      // edits before first lookup
+      doc.RemoveRow("r0");
+      unittest::ExpectEqual(int, doc.GetRowIdx("r0"), -1);
+      unittest::ExpectEqual(int, doc.GetRowIdx("r1"), 0);
+      unittest::ExpectEqual(int, doc.GetRowIdx("r3"), 2);
+
+      // edits after lookup update the built index
+      doc.InsertRow<int>(1, std::vector<int>({ 5, 25 }), "r5");
+      unittest::ExpectEqual(int, doc.GetRowIdx("r1"), 0);
+      unittest::ExpectEqual(int, doc.GetRowIdx("r5"), 1);
+      unittest::ExpectEqual(int, doc.GetRowIdx("r2"), 2);
+      unittest::ExpectEqual(int, doc.GetRowIdx("r3"), 3);
+      unittest::ExpectEqual(int, doc.GetRowIdx(""), -1);
+      unittest::ExpectEqual(int, doc.GetCell<int>("B", "r5"), 25);
+
+      doc.RemoveRow("r2");
+      unittest::ExpectEqual(int, doc.GetRowIdx("r2"), -1);
+      unittest::ExpectEqual(int, doc.GetRowIdx("r3"), 2);
+      unittest::ExpectEqual(int, doc.GetCell<int>("B", "r3"), 9);
+
+      doc.SetRowName(0, "r6");
+      unittest::ExpectEqual(int, doc.GetRowIdx("r1"), -1);
+      unittest::ExpectEqual(int, doc.GetRowIdx("r6"), 0);
+
+      // duplicate labels, last one wins
+      doc.SetRowName(0, "r3");
+      unittest::ExpectEqual(int, doc.GetRowIdx("r3"), 2);
+      doc.RemoveRow(2);
+      unittest::ExpectEqual(int, doc.GetRowIdx("r3"), 0);
+      unittest::ExpectEqual(int, doc.GetRowIdx("r5"), 1);
+
+      // inserting beyond the last row adds unlabeled padding rows
+      doc.InsertRow<int>(4, std::vector<int>({ 7, 49 }), "r7");
+      unittest::ExpectEqual(int, doc.GetRowIdx("r7"), 4);
+      unittest::ExpectEqual(int, doc.GetRowIdx(""), 3);
+
+      // copies keep an independent index
+      rapidcsv::Document copy = doc;
+      copy.RemoveRow("r3");
+      unittest::ExpectEqual(int, copy.GetRowIdx("r7"), 3);
+      unittest::ExpectEqual(int, doc.GetRowIdx("r7"), 4);
+
+      // reload drops the index
+      doc.Load(path, rapidcsv::LabelParams(0, 0));
+      unittest::ExpectEqual(int, doc.GetRowIdx("r0"), 0);
+      unittest::ExpectEqual(int, doc.GetRowIdx("r7"), -1);
+    }
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
@@ -0,0 +1,99 @@
+// test117.cpp - column and row handles
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B,C\n"
+    "1,3,9,81\n"
+    "2,4,16,256\n"
+  ;
+
+  std::string path = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    for (const bool arenaStorage : { false, true })
+    {
+      rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                             rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                             rapidcsv::LoadParams(false, 1, arenaStorage));
+
+      const rapidcsv::ColumnHandle<int> colB = doc.GetColumnHandle<int>("B");
+      unittest::ExpectEqual(size_t, colB.GetColumnIdx(), 1);
+      unittest::ExpectEqual(int, doc.GetCell(colB, 0), 9);
+      unittest::ExpectEqual(int, doc.GetCell(colB, 1), 16);
+      ExpectException(doc.GetCell(colB, 2), std::out_of_range);
+
+      const rapidcsv::ColumnHandle<double> colC = doc.GetColumnHandle<double>(2);
+      const rapidcsv::RowHandle row2 = doc.GetRowHandle("2");
+      unittest::ExpectEqual(size_t, row2.GetRowIdx(), 1);
+      unittest::ExpectEqual(double, doc.GetCell(colC, row2), 256.0);
+      unittest::ExpectEqual(double, doc.GetCell(colC, doc.GetRowHandle(0)), 81.0);
+
+      const rapidcsv::ColumnHandle<std::string> colA = doc.GetColumnHandle<std::string>("A");
+      unittest::ExpectEqual(std::string, doc.GetCell(colA, row2), "4");
+
+      ExpectException(doc.GetColumnHandle<int>("D"), std::out_of_range);
+      ExpectException(doc.GetColumnHandle<int>(3), std::out_of_range);
+      ExpectException(doc.GetRowHandle("3"), std::out_of_range);
+      ExpectException(doc.GetRowHandle(2), std::out_of_range);
+
+      // cell values set after resolving the handle are seen
+      doc.SetCell<int>("B", "1", 10);
+      unittest::ExpectEqual(int, doc.GetCell(colB, 0), 10);
+    }
+
+    // handles use the converter parameters of the document
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                           rapidcsv::ConverterParams(true, -1.0, -1));
+    doc.SetCell<std::string>("A", "1", "x");
+    const rapidcsv::ColumnHandle<int> colA = doc.GetColumnHandle<int>("A");
+    unittest::ExpectEqual(int, doc.GetCell(colA, 0), -1);
+    unittest::ExpectEqual(int, doc.GetCell(colA, 1), 4);
+
+    // handles keep the converter parameters, also when copied and after the document is gone
+    std::unique_ptr<rapidcsv::ColumnHandle<int>> colACopy;
+    {
+      rapidcsv::Document tempDoc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                                 rapidcsv::ConverterParams(true, -1.0, -2));
+      const rapidcsv::ColumnHandle<int> tempColA = tempDoc.GetColumnHandle<int>("A");
+      colACopy.reset(new rapidcsv::ColumnHandle<int>(tempColA));
+    }
+    unittest::ExpectEqual(int, doc.GetCell(*colACopy, 0), -2);
+    unittest::ExpectEqual(int, doc.GetCell(*colACopy, 1), 4);
+
+    doc.Load(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(), rapidcsv::ConverterParams());
+    doc.SetCell<std::string>("A", "1", "y");
+    unittest::ExpectEqual(int, doc.GetCell(colA, 0), -1);
+
+    // handles can be assigned, e.g. to resolve them again after the document is reloaded
+    rapidcsv::ColumnHandle<int> col = doc.GetColumnHandle<int>("B");
+    unittest::ExpectEqual(int, doc.GetCell(col, 1), 16);
+    col = doc.GetColumnHandle<int>("A");
+    unittest::ExpectEqual(size_t, col.GetColumnIdx(), 0);
+    unittest::ExpectEqual(int, doc.GetCell(col, 1), 4);
+    ExpectException(doc.GetCell(col, 0), std::invalid_argument);
+    col = colA;
+    unittest::ExpectEqual(int, doc.GetCell(col, 0), -1);
+
+    std::vector<rapidcsv::ColumnHandle<int>> cols(2, col);
+    cols[1] = doc.GetColumnHandle<int>("C");
+    unittest::ExpectEqual(int, doc.GetCell(cols[0], 1), 4);
+    unittest::ExpectEqual(int, doc.GetCell(cols[1], 1), 256);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
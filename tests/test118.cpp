@@ -0,0 +1,100 @@
+// test118.cpp - batch row and column removal
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B,C,D,E\n"
+    "0,0,1,2,3,4\n"
+    "1,10,11,12,13,14\n"
+    "2,20,21,22,23,24\n"
+    "3,30,31,32,33,34\n"
+    "4,40,41,42,43,44\n"
+  ;
+
+  std::string path = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    for (const bool arenaStorage : { false, true })
+    {
+      rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                             rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                             rapidcsv::LoadParams(false, 1, arenaStorage));
+
+      // rows by index, unordered and with duplicates
+      unittest::ExpectEqual(int, doc.GetRowIdx("4"), 4);
+      doc.RemoveRows(std::vector<size_t>({ 3, 0, 3 }));
+      unittest::ExpectEqual(size_t, doc.GetRowCount(), 3);
+      unittest::ExpectEqual(std::string, doc.GetRowName(0), "1");
+      unittest::ExpectEqual(std::string, doc.GetRowName(2), "4");
+      unittest::ExpectEqual(int, doc.GetRowIdx("4"), 2);
+      unittest::ExpectEqual(int, doc.GetRowIdx("3"), -1);
+      unittest::ExpectEqual(int, doc.GetCell<int>("B", "2"), 21);
+
+      ExpectException(doc.RemoveRows(std::vector<size_t>({ 0, 3 })), std::out_of_range);
+      unittest::ExpectEqual(size_t, doc.GetRowCount(), 3);
+      doc.RemoveRows(std::vector<size_t>());
+      unittest::ExpectEqual(size_t, doc.GetRowCount(), 3);
+
+      // columns by index
+      const std::vector<int>& colE = doc.GetColumnCached<int>("E");
+      unittest::ExpectEqual(int, colE.at(0), 14);
+      doc.RemoveColumns(std::vector<size_t>({ 3, 1 }));
+      unittest::ExpectEqual(size_t, doc.GetColumnCount(), 3);
+      unittest::ExpectTrue(doc.GetColumnNames() == std::vector<std::string>({ "A", "C", "E" }));
+      unittest::ExpectEqual(int, doc.GetColumnIdx("E"), 2);
+      unittest::ExpectEqual(int, doc.GetColumnIdx("B"), -1);
+      unittest::ExpectEqual(int, doc.GetColumnCached<int>("E").at(2), 44);
+      unittest::ExpectEqual(std::string, doc.GetRowName(1), "2");
+
+      ExpectException(doc.RemoveColumns(std::vector<size_t>({ 3 })), std::out_of_range);
+      unittest::ExpectEqual(size_t, doc.GetColumnCount(), 3);
+
+      // predicates
+      doc.RemoveColumnsIf([&](const size_t pColumnIdx) { return doc.GetColumnName(pColumnIdx) == "C"; });
+      unittest::ExpectTrue(doc.GetColumnNames() == std::vector<std::string>({ "A", "E" }));
+
+      doc.RemoveRowsIf([&](const size_t pRowIdx) { return doc.GetCell<int>("A", pRowIdx) >= 20; });
+      unittest::ExpectEqual(size_t, doc.GetRowCount(), 1);
+      unittest::ExpectEqual(int, doc.GetCell<int>("E", "1"), 14);
+      unittest::ExpectEqual(int, doc.GetRowIdx("2"), -1);
+
+      doc.RemoveRowsIf([](const size_t) { return false; });
+      unittest::ExpectEqual(size_t, doc.GetRowCount(), 1);
+    }
+
+    // no labels
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(-1, -1));
+    doc.RemoveRowsIf([](const size_t pRowIdx) { return (pRowIdx % 2) == 0; });
+    unittest::ExpectEqual(size_t, doc.GetRowCount(), 3);
+    doc.RemoveColumns(std::vector<size_t>({ 0, 5 }));
+    unittest::ExpectEqual(size_t, doc.GetColumnCount(), 4);
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>(0, 0), "0");
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>(3, 2), "43");
+
+    // ragged rows, only removed columns must exist in all rows
+    std::istringstream sstream("A,B,C,D\n1,2,3,4\n5,6\n");
+    rapidcsv::Document raggedDoc(sstream, rapidcsv::LabelParams(0, -1));
+    ExpectException(raggedDoc.RemoveColumns(std::vector<size_t>({ 1, 3 })), std::out_of_range);
+    unittest::ExpectTrue(raggedDoc.GetColumnNames() == std::vector<std::string>({ "A", "B", "C", "D" }));
+    raggedDoc.RemoveColumnsIf([](const size_t pColumnIdx) { return pColumnIdx == 1; });
+    unittest::ExpectTrue(raggedDoc.GetColumnNames() == std::vector<std::string>({ "A", "C", "D" }));
+    unittest::ExpectTrue(raggedDoc.GetRow<std::string>(0) == std::vector<std::string>({ "1", "3", "4" }));
+    unittest::ExpectTrue(raggedDoc.GetRow<std::string>(1) == std::vector<std::string>({ "5" }));
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
@@ -0,0 +1,87 @@
+// test119.cpp - append rows and move overloads
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B\n"
+    "r0,0,0\n"
+    "r1,1,1\n"
+  ;
+
+  std::string path = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    for (const bool arenaStorage : { false, true })
+    {
+      rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                             rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                             rapidcsv::LoadParams(false, 1, arenaStorage));
+      unittest::ExpectEqual(int, doc.GetRowIdx("r1"), 1);
+
+      // typed append with row names
+      doc.AppendRows<int>(std::vector<std::vector<int>>({ { 2, 4 }, { 3, 9 } }),
+                          std::vector<std::string>({ "r2", "r3" }));
+      unittest::ExpectEqual(size_t, doc.GetRowCount(), 4);
+      unittest::ExpectEqual(int, doc.GetRowIdx("r3"), 3);
+      unittest::ExpectEqual(int, doc.GetCell<int>("B", "r2"), 4);
+
+      // move append, last duplicate label wins
+      std::vector<std::vector<std::string>> rows({ { "4", "16" }, { "5", "25" } });
+      doc.AppendRows(std::move(rows), std::vector<std::string>({ "r4", "r1" }));
+      unittest::ExpectTrue(rows.empty());
+      unittest::ExpectEqual(int, doc.GetRowIdx("r4"), 4);
+      unittest::ExpectEqual(int, doc.GetRowIdx("r1"), 5);
+      unittest::ExpectEqual(int, doc.GetCell<int>("B", "r1"), 25);
+
+      ExpectException(doc.AppendRows<int>(std::vector<std::vector<int>>({ { 1 } }),
+                                          std::vector<std::string>({ "a", "b" })), std::out_of_range);
+      unittest::ExpectEqual(size_t, doc.GetRowCount(), 6);
+
+      // move insert
+      std::vector<std::string> row({ "6", "36" });
+      doc.InsertRow(1, std::move(row), "r6");
+      unittest::ExpectEqual(int, doc.GetRowIdx("r6"), 1);
+      unittest::ExpectEqual(int, doc.GetRowIdx("r4"), 5);
+      unittest::ExpectEqual(int, doc.GetCell<int>("B", 1), 36);
+      unittest::ExpectEqual(std::string, doc.GetRowName(2), "r1");
+
+      // move set column
+      std::vector<std::string> column({ "a", "b", "c", "d", "e", "f", "g", "h" });
+      doc.SetColumn("A", std::move(column));
+      unittest::ExpectEqual(size_t, doc.GetRowCount(), 8);
+      unittest::ExpectEqual(std::string, doc.GetCell<std::string>("A", "r6"), "b");
+      unittest::ExpectEqual(std::string, doc.GetCell<std::string>(0, 7), "h");
+      unittest::ExpectEqual(std::string, doc.GetCell<std::string>("B", "r3"), "9");
+
+      std::vector<std::string> column2({ "x" });
+      doc.SetColumn(2, std::move(column2));
+      unittest::ExpectEqual(std::string, doc.GetCell<std::string>(2, 0), "x");
+      unittest::ExpectEqual(std::string, doc.GetColumnName(1), "B");
+    }
+
+    // append to an empty document with labels
+    rapidcsv::Document doc("", rapidcsv::LabelParams(0, -1));
+    doc.AppendRows<double>(std::vector<std::vector<double>>({ { 0.5, 1 }, { 2, 3 } }));
+    unittest::ExpectEqual(size_t, doc.GetRowCount(), 2);
+    unittest::ExpectEqual(double, doc.GetCell<double>(0, 0), 0.5);
+    unittest::ExpectEqual(double, doc.GetCell<double>(1, 1), 3.0);
+    ExpectException(doc.AppendRows<int>(std::vector<std::vector<int>>({ { 1 } }),
+                                        std::vector<std::string>({ "a" })), std::out_of_range);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
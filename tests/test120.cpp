@@ -0,0 +1,109 @@
+// test120.cpp - buffered writing, identical to per-cell stream output
+
+#include <random>
+#include <rapidcsv.h>
+#include "unittest.h"
+
+// Reference formatting of a cell, as previously written through the stream
+static std::string FormatCell(const std::string& pCell, const rapidcsv::SeparatorParams& pSeparatorParams)
+{
+  if (pSeparatorParams.mAutoQuote &&
+      ((pCell.find(pSeparatorParams.mSeparator) != std::string::npos) ||
+       (pCell.find(' ') != std::string::npos) ||
+       (pCell.find('\n') != std::string::npos)))
+  {
+    std::string str(1, pSeparatorParams.mQuoteChar);
+    for (const char ch : pCell)
+    {
+      str += ch;
+      if (ch == pSeparatorParams.mQuoteChar)
+      {
+        str += ch;
+      }
+    }
+    return str + pSeparatorParams.mQuoteChar;
+  }
+
+  return pCell;
+}
+
+int main()
+{
+  int rv = 0;
+
+  try
+  {
+    std::mt19937 rng(120);
+    const std::string alphabet = "abc, \n\r\"';|x0123456789";
+    std::uniform_int_distribution<size_t> charDist(0, alphabet.size() - 1);
+    std::uniform_int_distribution<size_t> lengthDist(0, 12);
+    std::uniform_int_distribution<size_t> longDist(0, 300);
+
+    std::vector<rapidcsv::SeparatorParams> separatorParams;
+    separatorParams.push_back(rapidcsv::SeparatorParams(',', false, false));
+    separatorParams.push_back(rapidcsv::SeparatorParams(';', false, true));
+    separatorParams.push_back(rapidcsv::SeparatorParams(',', false, false, false, true, '\''));
+    separatorParams.push_back(rapidcsv::SeparatorParams('|', false, false, false, false));
+
+    for (const rapidcsv::SeparatorParams& params : separatorParams)
+    {
+      rapidcsv::Document doc("", rapidcsv::LabelParams(-1, -1), params);
+      std::string expected;
+      for (size_t rowIdx = 0; rowIdx < 3000; ++rowIdx)
+      {
+        std::vector<std::string> row;
+        for (size_t columnIdx = 0; columnIdx < 5; ++columnIdx)
+        {
+          const size_t length = ((rowIdx % 7) == 0) ? longDist(rng) : lengthDist(rng);
+          std::string cell;
+          for (size_t i = 0; i < length; ++i)
+          {
+            cell += alphabet[charDist(rng)];
+          }
+
+          // long cells with special characters only near the end
+          if ((rowIdx % 11) == 0)
+          {
+            cell = std::string(130, 'y') + cell;
+          }
+
+          expected += FormatCell(cell, params) + (((columnIdx + 1) < 5) ? std::string(1, params.mSeparator) : "");
+          row.push_back(cell);
+        }
+        expected += params.mHasCR ? "\r\n" : "\n";
+        doc.InsertRow(rowIdx, std::move(row));
+      }
+
+      std::ostringstream stream;
+      doc.Save(stream);
+      unittest::ExpectTrue(stream.str() == expected);
+
+      // same output with scalar scanning
+      const rapidcsv::detail::SimdLevel simdLevel = rapidcsv::detail::GetSimdLevel();
+      rapidcsv::detail::SetSimdLevel(rapidcsv::detail::SimdScalar);
+      std::ostringstream scalarStream;
+      doc.Save(scalarStream);
+      rapidcsv::detail::SetSimdLevel(simdLevel);
+      unittest::ExpectTrue(scalarStream.str() == expected);
+    }
+
+    // arena storage is written without copying cells
+    const std::string csv = "a,\"b c\",\"d\"\"e f\"\n1,2,3\n";
+    const std::string path = unittest::TempPath();
+    unittest::WriteFile(path, csv);
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(-1, -1), rapidcsv::SeparatorParams(',', false, false),
+                           rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                           rapidcsv::LoadParams(false, 1, true));
+    std::ostringstream stream;
+    doc.Save(stream);
+    unittest::ExpectEqual(std::string, stream.str(), csv);
+    unittest::DeleteFile(path);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
@@ -0,0 +1,65 @@
+// test121.cpp - streaming writer
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string path = unittest::TempPath();
+
+  try
+  {
+    // stream output, same format as document save
+    const rapidcsv::SeparatorParams separatorParams(',', false, false);
+    std::ostringstream stream;
+    {
+      rapidcsv::Writer writer(stream, separatorParams);
+      writer.WriteRow("id", "name", "value");
+      writer.WriteRow(1, "a b", 0.5);
+      writer.WriteRow(2, std::string("c,\"d\""), -3LL);
+      writer.WriteRow(std::vector<int>({ 3, 4, 5 }));
+      writer.WriteRow(std::vector<std::string>({ "x", "", "y\nz" }));
+      writer.WriteRow('c', 1.5f, static_cast<unsigned short>(7));
+      writer.Flush();
+
+      rapidcsv::Document doc("", rapidcsv::LabelParams(-1, -1), separatorParams);
+      doc.InsertRow(0, std::vector<std::string>({ "id", "name", "value" }));
+      doc.InsertRow(1, std::vector<std::string>({ "1", "a b", "0.5" }));
+      doc.InsertRow(2, std::vector<std::string>({ "2", "c,\"d\"", "-3" }));
+      doc.InsertRow(3, std::vector<std::string>({ "3", "4", "5" }));
+      doc.InsertRow(4, std::vector<std::string>({ "x", "", "y\nz" }));
+      doc.InsertRow(5, std::vector<std::string>({ "c", "1.5", "7" }));
+      std::ostringstream docStream;
+      doc.Save(docStream);
+      unittest::ExpectEqual(std::string, stream.str(), docStream.str());
+    }
+
+    // file output exceeding the buffer, flushed on destruction
+    {
+      rapidcsv::Writer writer(path, rapidcsv::SeparatorParams(';', false, true));
+      for (int i = 0; i < 20000; ++i)
+      {
+        writer.WriteRow(i, i * 2, "row " + std::to_string(i));
+      }
+    }
+
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(-1, -1), rapidcsv::SeparatorParams(';'));
+    unittest::ExpectEqual(size_t, doc.GetRowCount(), 20000);
+    unittest::ExpectEqual(int, doc.GetCell<int>(1, 19999), 39998);
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>(2, 12345), "row 12345");
+    unittest::ExpectTrue(unittest::ReadFile(path).find("\r\n") != std::string::npos);
+
+    ExpectException(rapidcsv::Writer("/nonexistent/dir/file.csv"), std::ios_base::failure);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
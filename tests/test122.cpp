@@ -0,0 +1,68 @@
+// test122.cpp - parallel save, identical to sequential save
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string path = unittest::TempPath();
+  std::string outPath = unittest::TempPath();
+
+  try
+  {
+    // with utf-8 bom, quoted cells and enough rows for multiple batches
+    std::string csv = "\xef\xbb\xbf" "id,text,value\r\n";
+    for (int i = 0; i < 100000; ++i)
+    {
+      csv += std::to_string(i) + ",\"text " + std::to_string(i % 97) + "\"," + std::to_string(i * 3) + "\r\n";
+    }
+    unittest::WriteFile(path, csv);
+
+    for (const bool arenaStorage : { false, true })
+    {
+      rapidcsv::Document doc(path, rapidcsv::LabelParams(), rapidcsv::SeparatorParams(',', false, true),
+                             rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                             rapidcsv::LoadParams(false, 1, arenaStorage));
+
+      std::ostringstream sequential;
+      doc.Save(sequential);
+      unittest::ExpectEqual(size_t, sequential.str().size() + 3, csv.size());
+
+      for (const unsigned threads : { 0u, 1u, 2u, 3u, 8u })
+      {
+        std::ostringstream parallel;
+        doc.Save(parallel, rapidcsv::SaveParams(threads));
+        unittest::ExpectTrue(parallel.str() == sequential.str());
+
+        doc.Save(outPath, rapidcsv::SaveParams(threads));
+        unittest::ExpectTrue(unittest::ReadFile(outPath) == csv);
+      }
+    }
+
+    // small and empty documents
+    rapidcsv::Document doc("", rapidcsv::LabelParams(-1, -1));
+    doc.Save(outPath, rapidcsv::SaveParams(4));
+    unittest::ExpectEqual(std::string, unittest::ReadFile(outPath), "");
+
+    doc.SetCell<std::string>(1, 0, "a b");
+    std::ostringstream sequential;
+    doc.Save(sequential);
+    std::ostringstream parallel;
+    doc.Save(parallel, rapidcsv::SaveParams(4));
+    unittest::ExpectEqual(std::string, parallel.str(), sequential.str());
+
+    ExpectException(doc.Save("/nonexistent/dir/file.csv", rapidcsv::SaveParams(4)), std::ios_base::failure);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+  unittest::DeleteFile(outPath);
+
+  return rv;
+}
@@ -0,0 +1,115 @@
+// test123.cpp - atomic save
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+static bool TempFileExists(const std::string& pPath)
+{
+#ifndef _WIN32
+  const std::string dirPath = rapidcsv::detail::GetDirPath(pPath);
+  const std::string prefix = pPath.substr(pPath.rfind('/') + 1) + ".tmp";
+  DIR* dir = opendir(dirPath.c_str());
+  if (dir == nullptr)
+  {
+    return false;
+  }
+
+  bool exists = false;
+  while (const struct dirent* entry = readdir(dir))
+  {
+    exists = exists || (std::string(entry->d_name).compare(0, prefix.size(), prefix) == 0);
+  }
+
+  closedir(dir);
+  return exists;
+#else
+  (void)pPath;
+  return false;
+#endif
+}
+
+int main()
+{
+  int rv = 0;
+
+  std::string path = unittest::TempPath();
+
+  try
+  {
+    const std::string csv =
+      "-,A,B\n"
+      "1,3,9\n"
+      "2,4,16\n"
+    ;
+    unittest::WriteFile(path, csv);
+
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(',', false, false));
+    doc.SetCell<int>("A", "1", 5);
+
+#ifndef _WIN32
+    // a reader with the previous file open keeps seeing the complete previous contents
+    std::ifstream reader(path, std::ios::binary);
+#endif
+    for (const unsigned threads : { 1u, 2u })
+    {
+      doc.Save(path, rapidcsv::SaveParams(threads, true /* pAtomic */));
+      unittest::ExpectEqual(std::string, unittest::ReadFile(path), "-,A,B\n1,5,9\n2,4,16\n");
+      unittest::ExpectTrue(!TempFileExists(path));
+    }
+
+#ifndef _WIN32
+    std::stringstream previous;
+    previous << reader.rdbuf();
+    unittest::ExpectEqual(std::string, previous.str(), csv);
+#endif
+
+    // synced save
+    doc.SetCell<int>("B", "2", 7);
+    doc.Save(path, rapidcsv::SaveParams(1, true, true /* pSync */));
+    unittest::ExpectEqual(std::string, unittest::ReadFile(path), "-,A,B\n1,5,9\n2,4,7\n");
+
+    // save to new file, and to the load path
+    const std::string newPath = unittest::TempPath();
+    doc.Save(newPath, rapidcsv::SaveParams(1, true, true));
+    unittest::ExpectEqual(std::string, unittest::ReadFile(newPath), "-,A,B\n1,5,9\n2,4,7\n");
+    doc.SetCell<int>("B", "2", 8);
+    doc.Save(std::string(), rapidcsv::SaveParams(1, true));
+    unittest::ExpectEqual(std::string, unittest::ReadFile(newPath), "-,A,B\n1,5,9\n2,4,8\n");
+    unittest::DeleteFile(newPath);
+
+    // failure leaves no temporary file
+    const std::string badPath = "/nonexistent/dir/file.csv";
+    ExpectException(doc.Save(badPath, rapidcsv::SaveParams(1, true)), std::ios_base::failure);
+    unittest::ExpectTrue(!TempFileExists(badPath));
+
+    // temporary paths are unique per call
+    unittest::ExpectTrue(rapidcsv::detail::GetTempPath(path) != rapidcsv::detail::GetTempPath(path));
+
+#ifndef _WIN32
+    // permission bits of the target file are kept
+    unittest::ExpectEqual(int, chmod(path.c_str(), 0640), 0);
+    doc.Save(path, rapidcsv::SaveParams(1, true));
+    struct stat pathStat;
+    unittest::ExpectEqual(int, stat(path.c_str(), &pathStat), 0);
+    unittest::ExpectEqual(unsigned, static_cast<unsigned>(pathStat.st_mode & 07777), 0640u);
+#endif
+
+    unittest::ExpectEqual(std::string, rapidcsv::detail::GetDirPath("dir/sub/file.csv"), "dir/sub");
+    unittest::ExpectEqual(std::string, rapidcsv::detail::GetDirPath("/file.csv"), "/");
+    unittest::ExpectEqual(std::string, rapidcsv::detail::GetDirPath("file.csv"), ".");
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
@@ -0,0 +1,148 @@
+// test124.cpp - append save
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string path = unittest::TempPath();
+
+  try
+  {
+    const rapidcsv::SaveParams appendParams(1, false, false, true /* pAppend */);
+
+    // only appended rows are written
+    unittest::WriteFile(path, "A,B\n1,2\n");
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(0, -1), rapidcsv::SeparatorParams(',', false, false));
+    doc.AppendRows<int>({ { 3, 4 }, { 5, 6 } });
+    doc.Save(std::string(), appendParams);
+    unittest::ExpectEqual(std::string, unittest::ReadFile(path), "A,B\n1,2\n3,4\n5,6\n");
+
+    // nothing to append
+    doc.Save(std::string(), appendParams);
+    unittest::ExpectEqual(std::string, unittest::ReadFile(path), "A,B\n1,2\n3,4\n5,6\n");
+
+    // rows added after the last save, also with cells requiring quotes
+    doc.InsertRow<std::string>(doc.GetRowCount(), { "a,b", "c" });
+    doc.SetCell<int>(0, 4, 7);
+    doc.Save(std::string(), appendParams);
+    unittest::ExpectEqual(std::string, unittest::ReadFile(path), "A,B\n1,2\n3,4\n5,6\n\"a,b\",c\n7,\n");
+
+    // modified earlier rows or labels cause a full rewrite
+    doc.SetCell<int>(1, 0, 8);
+    doc.AppendRows<int>({ { 9, 10 } });
+    doc.Save(std::string(), appendParams);
+    unittest::ExpectEqual(std::string, unittest::ReadFile(path), "A,B\n1,8\n3,4\n5,6\n\"a,b\",c\n7,\n9,10\n");
+
+    doc.RemoveRow(5);
+    doc.Save(std::string(), appendParams);
+    unittest::ExpectEqual(std::string, unittest::ReadFile(path), "A,B\n1,8\n3,4\n5,6\n\"a,b\",c\n7,\n");
+
+    doc.SetColumnName(0, "C");
+    doc.Save(std::string(), appendParams);
+    unittest::ExpectEqual(std::string, unittest::ReadFile(path), "C,B\n1,8\n3,4\n5,6\n\"a,b\",c\n7,\n");
+
+    // widening the table affects all rows
+    doc.SetCell<int>(2, 5, 1);
+    doc.Save(std::string(), appendParams);
+    unittest::ExpectEqual(std::string, unittest::ReadFile(path), "C,B,\n1,8,\n3,4,\n5,6,\n\"a,b\",c,\n7,,\n,,1\n");
+
+    // saving to another path writes the full file, later appends go to that path
+    const std::string newPath = unittest::TempPath();
+    doc.AppendRows<int>({ { 2, 3, 4 } });
+    doc.Save(newPath, appendParams);
+    unittest::ExpectEqual(std::string, unittest::ReadFile(newPath),
+                          "C,B,\n1,8,\n3,4,\n5,6,\n\"a,b\",c,\n7,,\n,,1\n2,3,4\n");
+    doc.AppendRows<int>({ { 5, 6, 7 } });
+    doc.Save(std::string(), appendParams);
+    unittest::ExpectEqual(std::string, unittest::ReadFile(newPath),
+                          "C,B,\n1,8,\n3,4,\n5,6,\n\"a,b\",c,\n7,,\n,,1\n2,3,4\n5,6,7\n");
+    unittest::DeleteFile(newPath);
+
+    // a deleted file is written in full
+    doc.AppendRows<int>({ { 8, 9, 10 } });
+    unittest::DeleteFile(path);
+    doc.Save(path, appendParams);
+    unittest::ExpectEqual(std::string, unittest::ReadFile(path),
+                          "C,B,\n1,8,\n3,4,\n5,6,\n\"a,b\",c,\n7,,\n,,1\n2,3,4\n5,6,7\n8,9,10\n");
+
+    // crlf line endings and missing line end after the last row
+    unittest::WriteFile(path, "A,B\r\n1,2");
+    rapidcsv::Document docCR(path);
+    docCR.AppendRows<int>({ { 3, 4 } });
+    docCR.Save(std::string(), appendParams);
+    unittest::ExpectEqual(std::string, unittest::ReadFile(path), "A,B\r\n1,2\r\n3,4\r\n");
+
+    // utf-8 bom is kept
+    unittest::WriteFile(path, "\xef\xbb\xbf" "A,B\n1,2\n");
+    rapidcsv::Document docBOM(path);
+    docBOM.AppendRows<int>({ { 3, 4 } });
+    docBOM.Save(std::string(), appendParams);
+    unittest::ExpectEqual(std::string, unittest::ReadFile(path), "\xef\xbb\xbf" "A,B\n1,2\n3,4\n");
+
+#ifdef RAPIDCSV_HAS_MMAP
+    // a file changed by others since it was loaded or saved is written in full
+    unittest::WriteFile(path, "A,B\n1,2\n");
+    rapidcsv::Document docChanged(path, rapidcsv::LabelParams(0, -1));
+    unittest::WriteFile(path, "A,B\nxx,yy\n");
+    docChanged.AppendRows<int>({ { 3, 4 } });
+    docChanged.Save(std::string(), appendParams);
+    unittest::ExpectEqual(std::string, unittest::ReadFile(path), "A,B\n1,2\n3,4\n");
+
+    unittest::WriteFile(path, "A,B\n1,2\n3,4\nx,y\n");
+    docChanged.AppendRows<int>({ { 5, 6 } });
+    docChanged.Save(std::string(), appendParams);
+    unittest::ExpectEqual(std::string, unittest::ReadFile(path), "A,B\n1,2\n3,4\n5,6\n");
+
+    unittest::WriteFile(path, "A,B\n");
+    docChanged.AppendRows<int>({ { 7, 8 } });
+    docChanged.Save(std::string(), appendParams);
+    unittest::ExpectEqual(std::string, unittest::ReadFile(path), "A,B\n1,2\n3,4\n5,6\n7,8\n");
+
+    unittest::WriteFile(path, "");
+    docBOM.AppendRows<int>({ { 5, 6 } });
+    docBOM.Save(std::string(), appendParams);
+    unittest::ExpectEqual(std::string, unittest::ReadFile(path), "\xef\xbb\xbf" "A,B\n1,2\n3,4\n5,6\n");
+#endif
+
+    // documents loaded with selected columns or filtered rows are saved in full
+    unittest::WriteFile(path, "A,B,C\n1,2,3\n4,5,6\n");
+    rapidcsv::Document docSelect(path, rapidcsv::LabelParams(0, -1), rapidcsv::SeparatorParams(',', false, false),
+                                 rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                 rapidcsv::LoadParams(false, 1, false, std::vector<size_t>(),
+                                                      std::vector<std::string>({ "A", "C" })));
+    docSelect.AppendRows<int>({ { 7, 9 } });
+    docSelect.Save(std::string(), appendParams);
+    unittest::ExpectEqual(std::string, unittest::ReadFile(path), "A,C\n1,3\n4,6\n7,9\n");
+
+    unittest::WriteFile(path, "A,B\n1,2\n3,4\n");
+    rapidcsv::Document docFilter(path, rapidcsv::LabelParams(0, -1), rapidcsv::SeparatorParams(',', false, false),
+                                 rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                 rapidcsv::LoadParams(false, 1, false, std::vector<size_t>(), std::vector<std::string>(),
+                                                      [](const std::vector<std::string>& pRow)
+                                                      {
+                                                        return pRow.at(0) != "1";
+                                                      }));
+    docFilter.AppendRows<int>({ { 5, 6 } });
+    docFilter.Save(std::string(), appendParams);
+    unittest::ExpectEqual(std::string, unittest::ReadFile(path), "A,B\n3,4\n5,6\n");
+
+    // documents read from a stream are saved in full
+    std::istringstream sstream("A,B\n1,2\n");
+    rapidcsv::Document docStream(sstream);
+    docStream.AppendRows<int>({ { 3, 4 } });
+    docStream.Save(path, appendParams);
+    unittest::ExpectEqual(std::string, unittest::ReadFile(path), "A,B\n1,2\n3,4\n");
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
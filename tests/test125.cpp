@@ -0,0 +1,179 @@
+// test125.cpp - indexed reader
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+static bool FileExists(const std::string& pPath)
+{
+  std::ifstream file(pPath);
+  return file.good();
+}
+
+int main()
+{
+  int rv = 0;
+
+  std::string path = unittest::TempPath();
+  const std::string indexPath = path + ".idx";
+
+  try
+  {
+    // rows with quoted linebreaks, comments and empty lines
+    std::string csv = "\xef\xbb\xbf" "A,B,C\n";
+    for (int i = 0; i < 1000; ++i)
+    {
+      csv += std::to_string(i) + ",\"x\n" + std::to_string(i * 2) + "\",\"a,\"\"b\"\"\"\n";
+      if ((i % 7) == 0)
+      {
+        csv += "# comment " + std::to_string(i) + "\n\n";
+      }
+    }
+    csv += "end,1,2";
+    unittest::WriteFile(path, csv);
+
+    const rapidcsv::SeparatorParams separatorParams(',', false, rapidcsv::sPlatformHasCR, true /* pQuotedLinebreaks */);
+    const rapidcsv::LineReaderParams lineReaderParams(true /* pSkipCommentLines */, '#', true /* pSkipEmptyLines */);
+
+    std::vector<std::vector<std::string>> rows;
+    rapidcsv::Reader seqReader(path, separatorParams, rapidcsv::ConverterParams(), lineReaderParams);
+    std::vector<std::string> row;
+    while (seqReader.Next(row))
+    {
+      rows.push_back(row);
+    }
+    unittest::ExpectEqual(size_t, rows.size(), 1002);
+
+    for (const size_t interval : { 1u, 3u, 64u, 1024u, 5000u })
+    {
+      rapidcsv::IndexedReader reader(path, separatorParams, rapidcsv::ConverterParams(), lineReaderParams,
+                                     rapidcsv::IndexParams(interval));
+      unittest::ExpectEqual(size_t, reader.GetRowCount(), rows.size());
+
+      // random, backward and sequential access
+      for (size_t i = 0; i < rows.size(); ++i)
+      {
+        const size_t rowIdx = (i * 7919) % rows.size();
+        reader.GetRow(rowIdx, row);
+        unittest::ExpectTrue(row == rows[rowIdx]);
+      }
+
+      for (size_t i = rows.size(); i > 0; --i)
+      {
+        reader.GetRow(i - 1, row);
+        unittest::ExpectTrue(row == rows[i - 1]);
+      }
+
+      for (size_t i = 0; i < rows.size(); ++i)
+      {
+        reader.GetRow(i, row);
+        unittest::ExpectTrue(row == rows[i]);
+      }
+
+      unittest::ExpectEqual(std::string, reader.GetRow<std::string>(0).at(0), "A");
+      unittest::ExpectEqual(std::string, reader.GetRow<std::string>(500).at(1), "x\n998");
+      unittest::ExpectEqual(std::string, reader.GetRow<std::string>(1001).at(0), "end");
+      ExpectException(reader.GetRow(1002, row), std::out_of_range);
+    }
+
+    unittest::ExpectTrue(!FileExists(indexPath));
+
+#ifndef _WIN32
+    // index file is used while the csv file is unchanged
+    const rapidcsv::IndexParams indexParams(16, true /* pIndexFile */);
+    {
+      rapidcsv::IndexedReader reader(path, separatorParams, rapidcsv::ConverterParams(), lineReaderParams,
+                                     indexParams);
+      unittest::ExpectEqual(size_t, reader.GetRowCount(), 1002);
+    }
+    unittest::ExpectTrue(FileExists(indexPath));
+    const std::string index = unittest::ReadFile(indexPath);
+    unittest::ExpectEqual(std::string, index.substr(0, 15), "rapidcsv-index ");
+
+    {
+      rapidcsv::IndexedReader reader(path, separatorParams, rapidcsv::ConverterParams(), lineReaderParams,
+                                     indexParams);
+      unittest::ExpectEqual(size_t, reader.GetRowCount(), 1002);
+      unittest::ExpectEqual(std::string, reader.GetRow<std::string>(777).at(0), "776");
+    }
+    unittest::ExpectEqual(std::string, unittest::ReadFile(indexPath), index);
+
+    // index file contents are trusted without scanning
+    std::string modifiedIndex = index;
+    const size_t countPos = modifiedIndex.find("\n1002 63\n");
+    unittest::ExpectTrue(countPos != std::string::npos);
+    modifiedIndex.replace(countPos, 9, "\n1001 63\n");
+    unittest::WriteFile(indexPath, modifiedIndex);
+    {
+      rapidcsv::IndexedReader reader(path, separatorParams, rapidcsv::ConverterParams(), lineReaderParams,
+                                     indexParams);
+      unittest::ExpectEqual(size_t, reader.GetRowCount(), 1001);
+    }
+
+    // invalid index file is replaced
+    unittest::WriteFile(indexPath, index.substr(0, index.size() / 2));
+    {
+      rapidcsv::IndexedReader reader(path, separatorParams, rapidcsv::ConverterParams(), lineReaderParams,
+                                     indexParams);
+      unittest::ExpectEqual(size_t, reader.GetRowCount(), 1002);
+      unittest::ExpectEqual(std::string, reader.GetRow<std::string>(1001).at(0), "end");
+    }
+    unittest::ExpectEqual(std::string, unittest::ReadFile(indexPath), index);
+
+    // index file for other parameters is not used
+    {
+      rapidcsv::IndexedReader reader(path, separatorParams, rapidcsv::ConverterParams(),
+                                     rapidcsv::LineReaderParams(), indexParams);
+      unittest::ExpectEqual(size_t, reader.GetRowCount(), 1002 + 143 * 2);
+    }
+
+    // index file for other quoting is not used, as comment detection depends on it
+    {
+      const std::string quotedPath = unittest::TempPath();
+      unittest::WriteFile(quotedPath, "\"#q\",1\na,2\n");
+      const rapidcsv::LineReaderParams commentParams(true /* pSkipCommentLines */);
+      rapidcsv::IndexedReader autoQuoteReader(quotedPath, rapidcsv::SeparatorParams(), rapidcsv::ConverterParams(),
+                                              commentParams, indexParams);
+      unittest::ExpectEqual(size_t, autoQuoteReader.GetRowCount(), 1);
+      rapidcsv::IndexedReader noQuoteReader(quotedPath,
+                                            rapidcsv::SeparatorParams(',', false, rapidcsv::sPlatformHasCR, false,
+                                                                      false /* pAutoQuote */),
+                                            rapidcsv::ConverterParams(), commentParams, indexParams);
+      unittest::ExpectEqual(size_t, noQuoteReader.GetRowCount(), 2);
+      unittest::DeleteFile(quotedPath);
+      unittest::DeleteFile(quotedPath + ".idx");
+    }
+
+    // modified csv file is indexed again
+    unittest::WriteFile(path, csv + "\nlast,3,4\n");
+    {
+      rapidcsv::IndexedReader reader(path, separatorParams, rapidcsv::ConverterParams(), lineReaderParams,
+                                     indexParams);
+      unittest::ExpectEqual(size_t, reader.GetRowCount(), 1003);
+      unittest::ExpectEqual(std::string, reader.GetRow<std::string>(1002).at(0), "last");
+    }
+    unittest::ExpectTrue(unittest::ReadFile(indexPath) != index);
+#endif
+
+    // converted rows
+    unittest::WriteFile(path, "1,2,3\n4,5,6\n");
+    rapidcsv::IndexedReader intReader(path);
+    unittest::ExpectTrue(intReader.GetRow<int>(1) == std::vector<int>({ 4, 5, 6 }));
+    unittest::ExpectTrue(intReader.GetRow<int>(0) == std::vector<int>({ 1, 2, 3 }));
+
+    // empty file
+    unittest::WriteFile(path, "");
+    rapidcsv::IndexedReader emptyReader(path);
+    unittest::ExpectEqual(size_t, emptyReader.GetRowCount(), 0);
+    ExpectException(emptyReader.GetRow(0, row), std::out_of_range);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+  unittest::DeleteFile(indexPath);
+
+  return rv;
+}
@@ -0,0 +1,113 @@
+// test126.cpp - row count and header without loading
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+static size_t LoadRowCount(const std::string& pPath, const rapidcsv::SeparatorParams& pSeparatorParams,
+                           const rapidcsv::LineReaderParams& pLineReaderParams)
+{
+  rapidcsv::Document doc(pPath, rapidcsv::LabelParams(-1, -1), pSeparatorParams, rapidcsv::ConverterParams(),
+                         pLineReaderParams);
+  return doc.GetRowCount();
+}
+
+int main()
+{
+  int rv = 0;
+
+  std::string path = unittest::TempPath();
+
+  try
+  {
+    const std::vector<std::string> csvs =
+    {
+      "",
+      "\n",
+      "\r\n\r\n",
+      "A,B\n1,2\n",
+      "A,B\n1,2",
+      "A,B\r\n1,2\r\n\r\n3,4\r",
+      "\xef\xbb\xbf" "A,B\n\n1,2\n",
+      "\xef\xbb\xbf\n1,2\n",
+      "A,B\n# comment\n 1,2\n  # indented comment\n\"# quoted comment\"\n,\n",
+      "A,\"B\nC\"\n1,\"2\r\n\r\n3\"\n\n\"a\"\"\n\"\"b\",x\n",
+      "A,B\nx\"y\n,z\"\n \"q\n\",1\n",
+    };
+
+    const std::vector<rapidcsv::SeparatorParams> separatorParamsList =
+    {
+      rapidcsv::SeparatorParams(),
+      rapidcsv::SeparatorParams(',', true /* pTrim */),
+      rapidcsv::SeparatorParams(',', false, rapidcsv::sPlatformHasCR, true /* pQuotedLinebreaks */),
+      rapidcsv::SeparatorParams(',', true, rapidcsv::sPlatformHasCR, true),
+    };
+
+    const std::vector<rapidcsv::LineReaderParams> lineReaderParamsList =
+    {
+      rapidcsv::LineReaderParams(),
+      rapidcsv::LineReaderParams(true /* pSkipCommentLines */),
+      rapidcsv::LineReaderParams(false, '#', true /* pSkipEmptyLines */),
+      rapidcsv::LineReaderParams(true, '#', true),
+    };
+
+    // same row count as when loading, for all combinations
+    for (const auto& csv : csvs)
+    {
+      unittest::WriteFile(path, csv);
+      for (const auto& separatorParams : separatorParamsList)
+      {
+        for (const auto& lineReaderParams : lineReaderParamsList)
+        {
+          unittest::ExpectEqual(size_t, rapidcsv::Reader::CountRows(path, separatorParams, lineReaderParams),
+                                LoadRowCount(path, separatorParams, lineReaderParams));
+        }
+      }
+    }
+
+    // row count spanning many buffers
+    std::string csv = "id,text\n";
+    for (int i = 0; i < 100000; ++i)
+    {
+      csv += std::to_string(i) + ",\"line\nbreak\"\r\n";
+      if ((i % 1000) == 0)
+      {
+        csv += "\n#comment\n";
+      }
+    }
+    unittest::WriteFile(path, csv);
+    const rapidcsv::SeparatorParams quotedParams(',', false, rapidcsv::sPlatformHasCR, true);
+    const rapidcsv::LineReaderParams skipParams(true, '#', true);
+    unittest::ExpectEqual(size_t, rapidcsv::Reader::CountRows(path), 200000 + 1 + 200);
+    unittest::ExpectEqual(size_t, rapidcsv::Reader::CountRows(path, rapidcsv::SeparatorParams(), skipParams),
+                          200000 + 1);
+    unittest::ExpectEqual(size_t, rapidcsv::Reader::CountRows(path, quotedParams), 100000 + 1 + 200);
+    unittest::ExpectEqual(size_t, rapidcsv::Reader::CountRows(path, quotedParams, skipParams), 100000 + 1);
+
+    // header
+    unittest::WriteFile(path, "\xef\xbb\xbf" "# comment\n\n\"A,1\", B ,C\n1,2,3\n");
+    std::vector<std::string> header = rapidcsv::Reader::ReadHeader(path);
+    unittest::ExpectEqual(size_t, header.size(), 1);
+    unittest::ExpectEqual(std::string, header.at(0), "# comment");
+
+    header = rapidcsv::Reader::ReadHeader(path, rapidcsv::SeparatorParams(',', true /* pTrim */), skipParams);
+    unittest::ExpectEqual(size_t, header.size(), 3);
+    unittest::ExpectEqual(std::string, header.at(0), "A,1");
+    unittest::ExpectEqual(std::string, header.at(1), "B");
+    unittest::ExpectEqual(std::string, header.at(2), "C");
+
+    unittest::WriteFile(path, "");
+    unittest::ExpectTrue(rapidcsv::Reader::ReadHeader(path).empty());
+
+    ExpectException(rapidcsv::Reader::CountRows(path + ".missing"), std::ios_base::failure);
+    ExpectException(rapidcsv::Reader::ReadHeader(path + ".missing"), std::ios_base::failure);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
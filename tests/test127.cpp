@@ -0,0 +1,80 @@
+// test127.cpp - reserve and load size estimate
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string path = unittest::TempPath();
+
+  try
+  {
+    // reserve before building a document cell by cell
+    rapidcsv::Document doc("", rapidcsv::LabelParams(0, 0));
+    doc.Reserve(100, 3);
+    doc.SetColumnName(0, "A");
+    doc.SetColumnName(1, "B");
+    doc.SetColumnName(2, "C");
+    for (size_t rowIdx = 0; rowIdx < 100; ++rowIdx)
+    {
+      for (size_t columnIdx = 0; columnIdx < 3; ++columnIdx)
+      {
+        doc.SetCell<size_t>(columnIdx, rowIdx, rowIdx * 10 + columnIdx);
+      }
+      doc.SetRowName(rowIdx, "r" + std::to_string(rowIdx));
+    }
+
+    unittest::ExpectEqual(size_t, doc.GetRowCount(), 100);
+    unittest::ExpectEqual(size_t, doc.GetColumnCount(), 3);
+    unittest::ExpectEqual(size_t, doc.GetCell<size_t>("C", "r99"), 992);
+
+    // fewer or more rows and columns than reserved
+    doc.SetCell<int>(4, 120, 7);
+    unittest::ExpectEqual(size_t, doc.GetRowCount(), 121);
+    unittest::ExpectEqual(size_t, doc.GetColumnCount(), 5);
+    unittest::ExpectEqual(int, doc.GetCell<int>(4, 120), 7);
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>(3, 0), "");
+
+    rapidcsv::Document emptyDoc("", rapidcsv::LabelParams(-1, -1));
+    emptyDoc.Reserve(10);
+    unittest::ExpectEqual(size_t, emptyDoc.GetRowCount(), 0);
+    emptyDoc.AppendRows<int>({ { 1, 2 }, { 3 } });
+    unittest::ExpectEqual(size_t, emptyDoc.GetRowCount(), 2);
+    unittest::ExpectEqual(int, emptyDoc.GetCell<int>(1, 0), 2);
+
+    // reserve after loading, and loaded data not resembling its first block
+    std::string csv = "a\nb\n";
+    for (int i = 0; i < 20000; ++i)
+    {
+      csv += std::to_string(i) + ",x,y,\"long, quoted text " + std::to_string(i) + "\"\n";
+    }
+    unittest::WriteFile(path, csv);
+
+    for (const bool arenaStorage : { false, true })
+    {
+      rapidcsv::Document loadedDoc(path, rapidcsv::LabelParams(-1, -1), rapidcsv::SeparatorParams(),
+                                   rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                   rapidcsv::LoadParams(false, 1, arenaStorage));
+      unittest::ExpectEqual(size_t, loadedDoc.GetRowCount(), 20002);
+      unittest::ExpectEqual(std::string, loadedDoc.GetCell<std::string>(0, 1), "b");
+      unittest::ExpectEqual(std::string, loadedDoc.GetCell<std::string>(3, 20001), "long, quoted text 19999");
+
+      loadedDoc.Reserve(30000, 6);
+      loadedDoc.SetCell<int>(5, 25000, 1);
+      unittest::ExpectEqual(size_t, loadedDoc.GetRowCount(), 25001);
+      unittest::ExpectEqual(std::string, loadedDoc.GetCell<std::string>(3, 20001), "long, quoted text 19999");
+      unittest::ExpectEqual(size_t, loadedDoc.GetRow<std::string>(1).size(), 6);
+    }
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
@@ -169,4 +169,19 @@ namespace unittest
       throw std::runtime_error(ss.str());
     }
   }
+
+  template<typename TDocument>
+  inline void ExpectSameDocument(TDocument& pDoc, TDocument& pRefDoc)
+  {
+    ExpectEqual(size_t, pDoc.GetRowCount(), pRefDoc.GetRowCount());
+    ExpectEqual(size_t, pDoc.GetColumnCount(), pRefDoc.GetColumnCount());
+    ExpectTrue(pDoc.GetColumnNames() == pRefDoc.GetColumnNames());
+    ExpectTrue(pDoc.GetRowNames() == pRefDoc.GetRowNames());
+
+    std::ostringstream out;
+    pDoc.Save(out);
+    std::ostringstream refOut;
+    pRefDoc.Save(refOut);
+    ExpectEqual(std::string, out.str(), refOut.str());
+  }
 }